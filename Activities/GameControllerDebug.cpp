@@ -7,11 +7,54 @@
 #include <VBN/EngineUpdate.hpp>
 #include <VBN/GameControllerManager.hpp>
 #include <VBN/Logging.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Input/InputService.hpp"
+#include "../Graphics/RendererAccess.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../System/FastLog.hpp"
 #include <sstream>
+#include <algorithm>
+#include <iterator>
 #include <cmath>
 
+#define XBOX_CONTROLLER_TEXTURE "xbox_px"
 #define XBOX_CONTROLLER_TEXTURE_PATH "assets/textures/xbox_px.png"
-#define XBOX_CONTROLLER_TEXTURE_NAME "XBox360Controller"
+#define XBOX_CONTROLLER_CLIPS "xbox_px.clips"
+#define XBOX_CONTROLLER_CLIPS_PATH "assets/textures/xbox_px.clips"
+
+namespace
+{
+	struct ButtonSprite
+	{
+		SDL_GameControllerButton button;
+		char const * on;
+		char const * off;
+	};
+
+	/* Every displayed button and the clips standing for its two states */
+	ButtonSprite const BUTTON_SPRITES[] = {
+		{ SDL_CONTROLLER_BUTTON_A, "A_on", "A_off" },
+		{ SDL_CONTROLLER_BUTTON_B, "B_on", "B_off" },
+		{ SDL_CONTROLLER_BUTTON_X, "X_on", "X_off" },
+		{ SDL_CONTROLLER_BUTTON_Y, "Y_on", "Y_off" },
+		{ SDL_CONTROLLER_BUTTON_DPAD_DOWN, "DOWN_on", "DOWN_off" },
+		{ SDL_CONTROLLER_BUTTON_DPAD_RIGHT, "RIGHT_on", "RIGHT_off" },
+		{ SDL_CONTROLLER_BUTTON_DPAD_LEFT, "LEFT_on", "LEFT_off" },
+		{ SDL_CONTROLLER_BUTTON_DPAD_UP, "UP_on", "UP_off" },
+		{ SDL_CONTROLLER_BUTTON_BACK, "BACK_on", "BACK_off" },
+		{ SDL_CONTROLLER_BUTTON_START, "START_on", "START_off" },
+		{ SDL_CONTROLLER_BUTTON_GUIDE, "GUIDE_on", "GUIDE_off" },
+		{ SDL_CONTROLLER_BUTTON_LEFTSHOULDER, "LSH_on", "LSH_off" },
+		{ SDL_CONTROLLER_BUTTON_RIGHTSHOULDER, "RSH_on", "RSH_off" },
+		{ SDL_CONTROLLER_BUTTON_LEFTSTICK, "JOY_on", "JOY_off" },
+		{ SDL_CONTROLLER_BUTTON_RIGHTSTICK, "JOY_on", "JOY_off" }
+	};
+
+	char const * const LEFT_TRIGGER_CLIPS[TRIGGER_LEVELS] = {
+		"LTR_0", "LTR_1", "LTR_2", "LTR_3", "LTR_4", "LTR_5" };
+	char const * const RIGHT_TRIGGER_CLIPS[TRIGGER_LEVELS] = {
+		"RTR_0", "RTR_1", "RTR_2", "RTR_3", "RTR_4", "RTR_5" };
+}
 
 /* ----------------------------------------------- */
 /* ------------------- FACTORY ------------------- */
@@ -21,82 +64,72 @@ std::shared_ptr<GameContext> GameControllerDebug::Factory::createGameControllerD
 {
 	std::shared_ptr<GameControllerDebug::Model> model(
 		std::make_shared<GameControllerDebug::Model>(platform));
+	std::shared_ptr<GameControllerDebug::View> view(
+		std::make_shared<GameControllerDebug::View>(platform, model));
 
-	return Global::Factory::createGlobal(
+	std::shared_ptr<GameContext> context(Global::Factory::createGlobal(
 		platform,
 		model,
-		std::make_shared<GameControllerDebug::View>(platform, model),
+		view,
 		nullptr,
 		std::make_shared<GameControllerDebug::KeyboardEventHandler>(),
 		std::make_shared<GameControllerDebug::GameControllerEventHandler>(
-			platform, model),
+			platform, model, view),
 		nullptr,
-		nullptr);
+		nullptr));
+
+	/* The model samples the whole controller each update anyway */
+	context->setCoalescing(true);
+
+	return context;
+}
+
+/* The loose sheet is what the view falls back to when no atlas was built */
+AssetLoader::Manifest GameControllerDebug::Factory::getAssets(void)
+{
+	AssetLoader::Manifest manifest(SpriteSheet::getAtlasAssets());
+
+	manifest.push_back({ AssetLoader::IMAGE,
+		XBOX_CONTROLLER_TEXTURE, XBOX_CONTROLLER_TEXTURE_PATH });
+	manifest.push_back({ AssetLoader::DATA,
+		XBOX_CONTROLLER_CLIPS, XBOX_CONTROLLER_CLIPS_PATH });
+
+	return manifest;
 }
 
 /* ----------------------------------------------- */
 /* -------------------- MODEL -------------------- */
 /* ----------------------------------------------- */
 
-GameControllerDebug::Model::Model(std::shared_ptr<Platform> platform) : _platform(platform)
+GameControllerDebug::Model::Model(std::shared_ptr<Platform> platform) :
+	_platform(platform),
+	_player(0),
+	_buttons(0)
 {}
 
 void GameControllerDebug::Model::elapse(Uint32 const gameTicks,
 	std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	GameControllerManager * gameControllerManager(nullptr);
-	GameController * gameController(nullptr);
-	SDL_GameController * sdlController(nullptr);
-
-	gameControllerManager = _platform->getGameControllerManager();
-	if(gameControllerManager)
-		gameController = gameControllerManager->getControllerFromDeviceID(0);
-	if(gameController)
-		sdlController = gameController->getSDLGameController();
-	if (sdlController)
-	{
-		_leftJoystick.first =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_LEFTX) / 256;
-
-		_leftJoystick.second =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_LEFTY) / 256;
-
-		_rightJoystick.first =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_RIGHTX) / 256;
-
-		_rightJoystick.second =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_RIGHTY) / 256;
+	InputSnapshot const & input(InputService::getInstance()->getSnapshot());
 
-		_triggers.first =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_TRIGGERLEFT) / 256;
-
-		_triggers.second =
-			SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_TRIGGERRIGHT) / 256;
-
-		_buttons["A"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_A);
-		_buttons["B"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_B);
-		_buttons["X"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_X);
-		_buttons["Y"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_Y);
-
-		_buttons["UP"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_DPAD_UP);
-		_buttons["DOWN"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_DPAD_DOWN);
-		_buttons["LEFT"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_DPAD_LEFT);
-		_buttons["RIGHT"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_DPAD_RIGHT);
-
-		_buttons["LSTICK"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_LEFTSTICK);
-		_buttons["RSTICK"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_RIGHTSTICK);
-		_buttons["LSHOULDER"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_LEFTSHOULDER);
-		_buttons["RSHOULDER"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_RIGHTSHOULDER);
+	_buttons = 0;
+	if (input.isConnected(_player))
+	{
+		Sint16 const * axes(input.axes[_player]);
 
-		_buttons["START"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_START);
-		_buttons["BACK"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_BACK);
-		_buttons["GUIDE"] = SDL_GameControllerGetButton(sdlController, SDL_CONTROLLER_BUTTON_GUIDE);
+		_buttons = input.buttons[_player];
+		_leftJoystick.first = axes[SDL_CONTROLLER_AXIS_LEFTX] / 256;
+		_leftJoystick.second = axes[SDL_CONTROLLER_AXIS_LEFTY] / 256;
+		_rightJoystick.first = axes[SDL_CONTROLLER_AXIS_RIGHTX] / 256;
+		_rightJoystick.second = axes[SDL_CONTROLLER_AXIS_RIGHTY] / 256;
+		_triggers.first = axes[SDL_CONTROLLER_AXIS_TRIGGERLEFT] / 256;
+		_triggers.second = axes[SDL_CONTROLLER_AXIS_TRIGGERRIGHT] / 256;
 
 		_leftPole.first = fmin(sqrt(pow(_leftJoystick.first, 2.) + pow(_leftJoystick.second, 2.)), 120.f)/10;
 		_leftPole.second = atan2((double)(_leftJoystick.second), (double)(_leftJoystick.first));// *(180.f / M_PI);
 		_rightPole.first = fmin(sqrt(pow(_rightJoystick.first, 2.) + pow(_rightJoystick.second, 2.)), 120.f)/10;
 		_rightPole.second = atan2((double)(_rightJoystick.second), (double)(_rightJoystick.first));// *(180.f / M_PI);
-		VERBOSE(SDL_LOG_CATEGORY_APPLICATION, "r : %f - theta : %f", _leftPole.first, _leftPole.second);
+		FAST_VERBOSE(SDL_LOG_CATEGORY_APPLICATION, "r : %f - theta : %f", _leftPole.first, _leftPole.second);
 	}
 }
 
@@ -125,14 +158,19 @@ std::pair<Sint16, Sint16> GameControllerDebug::Model::getTriggers(void)
 	return _triggers;
 }
 
-bool GameControllerDebug::Model::getButton(std::string const & button)
+bool GameControllerDebug::Model::getButton(SDL_GameControllerButton const button) const
 {
-	return _buttons[button];
+	return (_buttons & (1u << button)) != 0;
 }
 
-std::map<std::string, bool> const & GameControllerDebug::Model::getButtons(void) const
+int GameControllerDebug::Model::getPlayer(void) const
 {
-	return _buttons;
+	return _player;
+}
+
+void GameControllerDebug::Model::setPlayer(int const player)
+{
+	_player = player;
 }
 
 /* ---------------------------------------------- */
@@ -142,60 +180,42 @@ std::map<std::string, bool> const & GameControllerDebug::Model::getButtons(void)
 GameControllerDebug::View::View(std::shared_ptr<Platform> platform,
 	std::shared_ptr<Model> model) :
 	_platform(platform),
-	_model(model)
+	_model(model),
+	_sheetGeneration(0)
+{
+	loadSheet();
+}
+
+/* Again when the device was lost : the sheet's texture went with it */
+void GameControllerDebug::View::loadSheet(void)
 {
 	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
-	Renderer * renderer(nullptr);
-	if (mainWindow)
-		renderer = mainWindow->getRenderer();
+	std::shared_ptr<AssetLoader> loader(AssetLoader::getInstance());
+
+	/*
+	 * Pushed without a loading screen : load the assets here. No atlas
+	 * built : the loose sheet, if any.
+	 */
+	loader->load(getSDLRenderer(mainWindow), Factory::getAssets());
+	_sheetGeneration = loader->getTextureGeneration();
+	_sheet = SpriteSheet::getAtlas();
+	if (!_sheet)
+		_sheet = SpriteSheet::getResident(XBOX_CONTROLLER_TEXTURE, XBOX_CONTROLLER_CLIPS);
+	if (!_sheet)
+		_sheet.reset(new SpriteSheet(nullptr));
+
+	std::fill(std::begin(_buttonOn), std::end(_buttonOn), -1);
+	std::fill(std::begin(_buttonOff), std::end(_buttonOff), -1);
+	for (ButtonSprite const & sprite : BUTTON_SPRITES)
+	{
+		_buttonOn[sprite.button] = _sheet->getHandle(sprite.on);
+		_buttonOff[sprite.button] = _sheet->getHandle(sprite.off);
+	}
 
-	if (renderer && !renderer->getTexture(XBOX_CONTROLLER_TEXTURE_NAME))
+	for (int level(0); level < TRIGGER_LEVELS; ++level)
 	{
-		renderer->addImageTexture(
-			XBOX_CONTROLLER_TEXTURE_NAME,
-			XBOX_CONTROLLER_TEXTURE_PATH);
-
-		Texture * controller = renderer->getTexture(XBOX_CONTROLLER_TEXTURE_NAME);
-		controller->addClip("A_off", { 0, 0, 32, 32 });
-		controller->addClip("A_on", { 32, 0, 32, 32 });
-		controller->addClip("B_off", { 64, 0, 32, 32 });
-		controller->addClip("B_on", { 96, 0, 32, 32 });
-		controller->addClip("X_off", { 128, 0, 32, 32 });
-		controller->addClip("X_on", { 160, 0, 32, 32 });
-		controller->addClip("Y_off", { 192, 0, 32, 32 });
-		controller->addClip("Y_on", { 224, 0, 32, 32 });
-		controller->addClip("LEFT_off", { 0, 32, 32, 32 });
-		controller->addClip("LEFT_on", { 32, 32, 32, 32 });
-		controller->addClip("RIGHT_off", { 64, 32, 32, 32 });
-		controller->addClip("RIGHT_on", { 96, 32, 32, 32 });
-		controller->addClip("UP_off", { 128, 32, 32, 32 });
-		controller->addClip("UP_on", { 160, 32, 32, 32 });
-		controller->addClip("DOWN_off", { 192, 32, 32, 32 });
-		controller->addClip("DOWN_on", { 224, 32, 32, 32 });
-		controller->addClip("BACK_off", { 0, 64, 32, 32 });
-		controller->addClip("BACK_on", { 32, 64, 32, 32 });
-		controller->addClip("START_off", { 64, 64, 32, 32 });
-		controller->addClip("START_on", { 96, 64, 32, 32 });
-		controller->addClip("RSH_off", { 128, 64, 32, 32 });
-		controller->addClip("RSH_on", { 160, 64, 32, 32 });
-		controller->addClip("LSH_off", { 192, 64, 32, 32 });
-		controller->addClip("LSH_on", { 224, 64, 32, 32 });
-		controller->addClip("LTR_0", { 0, 96, 32, 32 });
-		controller->addClip("LTR_1", { 32, 96, 32, 32 });
-		controller->addClip("LTR_2", { 64, 96, 32, 32 });
-		controller->addClip("LTR_3", { 96, 96, 32, 32 });
-		controller->addClip("LTR_4", { 128, 96, 32, 32 });
-		controller->addClip("LTR_5", { 160, 96, 32, 32 });
-		controller->addClip("RTR_0", { 192, 96, 32, 32 });
-		controller->addClip("RTR_1", { 224, 96, 32, 32 });
-		controller->addClip("RTR_2", { 0, 128, 32, 32 });
-		controller->addClip("RTR_3", { 32, 128, 32, 32 });
-		controller->addClip("RTR_4", { 64, 128, 32, 32 });
-		controller->addClip("RTR_5", { 96, 128, 32, 32 });
-		controller->addClip("GUIDE_off", { 128, 128, 32, 32 });
-		controller->addClip("GUIDE_on", { 160, 128, 32, 32 });
-		controller->addClip("JOY_off", { 0, 192, 32, 32 });
-		controller->addClip("JOY_on", { 32, 192, 32, 32 });
+		_leftTrigger[level] = _sheet->getHandle(LEFT_TRIGGER_CLIPS[level]);
+		_rightTrigger[level] = _sheet->getHandle(RIGHT_TRIGGER_CLIPS[level]);
 	}
 }
 
@@ -203,11 +223,19 @@ void GameControllerDebug::View::display(void)
 {
 	Window * mainWindow = _platform->getWindowManager()->getWindowByName("mainWindow");
 	Renderer * renderer = mainWindow->getRenderer();
+	SDL_Renderer * sdlRenderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
 
-	renderer->setDrawColor(0, 0, 0, 255);
-	renderer->fill();
+	if (_sheetGeneration != AssetLoader::getInstance()->getTextureGeneration())
+		loadSheet();
 
-	renderer->printText("DEBUG", "courier", 12, { 255, 255, 255, 255 }, {10, 10, 100, 22});
+	commands->setLayer(LAYER_BACKGROUND);
+	commands->fill(sdlRenderer, { 0, 0, 0, 255 });
+
+	std::shared_ptr<TextCache> text(TextCache::getInstance());
+	commands->setLayer(LAYER_TEXT);
+	text->printText(mainWindow,
+		"DEBUG", "courier", 12, { 255, 255, 255, 255 }, {10, 10, 100, 22});
 
 
 
@@ -221,20 +249,20 @@ void GameControllerDebug::View::display(void)
 
 	std::stringstream controllerStatus;
 	controllerStatus
+		<< "Player : " << _model->getPlayer() + 1 << '\n'
 		<< "Left Joystick : " << leftx << "," << lefty << '\n'
 		<< "Right Joystick : " << rightx << "," << righty << '\n'
 		<< "Triggers Status : " << ltrigger << "," << rtrigger << '\n'
-		<< "A : " << _model->getButton("A") << "\n"
-		<< "B : " << _model->getButton("B") << "\n"
-		<< "X : " << _model->getButton("X") << "\n"
-		<< "Y : " << _model->getButton("Y");
+		<< "A : " << _model->getButton(SDL_CONTROLLER_BUTTON_A) << "\n"
+		<< "B : " << _model->getButton(SDL_CONTROLLER_BUTTON_B) << "\n"
+		<< "X : " << _model->getButton(SDL_CONTROLLER_BUTTON_X) << "\n"
+		<< "Y : " << _model->getButton(SDL_CONTROLLER_BUTTON_Y);
 
-	renderer->printText(controllerStatus.str(),
+	text->printText(mainWindow, controllerStatus.str(),
 		"courier", 16, { 255, 255, 255, 255 },
 		{ 920, 20, 400, 300 });
 
 	// Draw left & right joystick crosshairs
-	renderer->setDrawColor(0, 194, 255, 255);
 	// LEFT
 	std::pair<double, double> leftPole = _model->getLeftPole();
 	//renderer->drawLine(232, 600, 232 + leftPole.first * cos(leftPole.second), 600 + leftPole.first * sin(leftPole.second));
@@ -283,117 +311,48 @@ void GameControllerDebug::View::display(void)
 	}
 	*/
 
-	if (_model->getButton("A"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "A_on", aDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "A_off", aDest);
-
-	if (_model->getButton("B"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "B_on", bDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "B_off", bDest);
-
-	if (_model->getButton("X"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "X_on", xDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "X_off", xDest);
-
-	if (_model->getButton("Y"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "Y_on", yDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "Y_off", yDest);
-
-	if (_model->getButton("DOWN"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "DOWN_on", dDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "DOWN_off", dDest);
-
-	if (_model->getButton("RIGHT"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RIGHT_on", rDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RIGHT_off", rDest);
-
-	if (_model->getButton("LEFT"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LEFT_on", lDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LEFT_off", lDest);
-
-	if (_model->getButton("UP"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "UP_on", uDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "UP_off", uDest);
-
-	if (_model->getButton("BACK"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "BACK_on", backDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "BACK_off", backDest);
-
-	if (_model->getButton("START"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "START_on", startDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "START_off", startDest);
-
-	if (_model->getButton("GUIDE"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "GUIDE_on", guideDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "GUIDE_off", guideDest);
-
-	if (_model->getButton("LSHOULDER"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LSH_on", lshDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LSH_off", lshDest);
-
-	if (_model->getButton("RSHOULDER"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RSH_on", rshDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RSH_off", rshDest);
-
-	if (_model->getButton("LSTICK"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "JOY_on", leftJoyDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "JOY_off", leftJoyDest);
-
-	if (_model->getButton("RSTICK"))
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "JOY_on", rightJoyDest);
-	else
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "JOY_off", rightJoyDest);
+	SDL_Rect destinations[SDL_CONTROLLER_BUTTON_MAX]{};
+	destinations[SDL_CONTROLLER_BUTTON_A] = aDest;
+	destinations[SDL_CONTROLLER_BUTTON_B] = bDest;
+	destinations[SDL_CONTROLLER_BUTTON_X] = xDest;
+	destinations[SDL_CONTROLLER_BUTTON_Y] = yDest;
+	destinations[SDL_CONTROLLER_BUTTON_BACK] = backDest;
+	destinations[SDL_CONTROLLER_BUTTON_GUIDE] = guideDest;
+	destinations[SDL_CONTROLLER_BUTTON_START] = startDest;
+	destinations[SDL_CONTROLLER_BUTTON_LEFTSTICK] = leftJoyDest;
+	destinations[SDL_CONTROLLER_BUTTON_RIGHTSTICK] = rightJoyDest;
+	destinations[SDL_CONTROLLER_BUTTON_LEFTSHOULDER] = lshDest;
+	destinations[SDL_CONTROLLER_BUTTON_RIGHTSHOULDER] = rshDest;
+	destinations[SDL_CONTROLLER_BUTTON_DPAD_UP] = uDest;
+	destinations[SDL_CONTROLLER_BUTTON_DPAD_DOWN] = dDest;
+	destinations[SDL_CONTROLLER_BUTTON_DPAD_LEFT] = lDest;
+	destinations[SDL_CONTROLLER_BUTTON_DPAD_RIGHT] = rDest;
+
+	_batch.begin(*_sheet);
+	for (ButtonSprite const & sprite : BUTTON_SPRITES)
+		_batch.add(_model->getButton(sprite.button)
+			? _buttonOn[sprite.button] : _buttonOff[sprite.button],
+			destinations[sprite.button]);
 
 	Sint16 leftT = ltrigger / 22;
 	Sint16 rightT = rtrigger / 22;
 
-	if (leftT == 0)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_0", ltDest);
-	else if(leftT == 1)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_1", ltDest);
-	else if(leftT == 2)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_2", ltDest);
-	else if(leftT == 3)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_3", ltDest);
-	else if(leftT == 4)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_4", ltDest);
-	else if(leftT == 5)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "LTR_5", ltDest);
-
-	if (rightT == 0)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_0", rtDest);
-	else if(rightT == 1)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_1", rtDest);
-	else if(rightT == 2)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_2", rtDest);
-	else if(rightT == 3)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_3", rtDest);
-	else if(rightT == 4)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_4", rtDest);
-	else if(rightT == 5)
-		renderer->copy(XBOX_CONTROLLER_TEXTURE_NAME, "RTR_5", rtDest);
+	if (leftT >= 0 && leftT < TRIGGER_LEVELS)
+		_batch.add(_leftTrigger[leftT], ltDest);
+
+	if (rightT >= 0 && rightT < TRIGGER_LEVELS)
+		_batch.add(_rightTrigger[rightT], rtDest);
+
+	commands->setLayer(LAYER_SPRITES);
+	_batch.submit(sdlRenderer);
 }
 
 /* ---------------------------------------------------- */
 /* -------------------- CONTROLLER -------------------- */
 /* ---------------------------------------------------- */
 
-void GameControllerDebug::KeyboardEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void GameControllerDebug::KeyboardEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch(event.type)
 	{
@@ -401,7 +360,7 @@ void GameControllerDebug::KeyboardEventHandler::handleEvent(SDL_Event const & ev
 			switch(event.key.keysym.sym)
 			{
 				case SDLK_ESCAPE:
-					engineUpdate->popGameContext();
+					context.engineUpdate.popGameContext();
 				break;
 			}
 		break;
@@ -410,51 +369,45 @@ void GameControllerDebug::KeyboardEventHandler::handleEvent(SDL_Event const & ev
 
 GameControllerDebug::GameControllerEventHandler::GameControllerEventHandler(
 	std::shared_ptr<Platform> platform,
-	std::shared_ptr<Model> model) :
+	std::shared_ptr<Model> model,
+	std::shared_ptr<View> view) :
 	_platform(platform),
-	_model(model)
+	_model(model),
+	_view(view)
 {}
 
 GameControllerDebug::GameControllerEventHandler::~GameControllerEventHandler(void)
 {}
 
-void GameControllerDebug::GameControllerEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> update)
+void GameControllerDebug::GameControllerEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
-	GameController * controller(nullptr);
-	SDL_Joystick * joystick(nullptr);
-	SDL_Haptic * haptic(nullptr);
-
-	controller = _platform
-		->getGameControllerManager()
-		->getControllerFromDeviceID(0);
-
-	if (controller)
-	{
-		joystick = controller->getSDLJoystick();
-		haptic = controller->getSDLHaptic();
-	}
+	int player(-1);
 
 	switch (event.type)
 	{
 		case SDL_CONTROLLERBUTTONDOWN:
+			player = InputService::getInstance()->getPlayer(event.cbutton.which);
+			if (player >= 0)
+				_model->setPlayer(player);
+
 			switch (event.cbutton.button)
 			{
 				case SDL_CONTROLLER_BUTTON_START:
 					DEBUG(SDL_LOG_CATEGORY_APPLICATION,
 						"Button START pressed on instance @%d",
 						event.cbutton.which);
-					update->pushGameContext(Pause::Factory::createPause(
-						_platform,
-						std::make_shared<GameControllerDebug::View>(
-							_platform,
-							_model)));
+					context.engineUpdate.pushGameContext(Pause::Factory::createPause(
+						_platform, context.gameContext
+							? context.gameContext->shared_from_this() : nullptr,
+						_view));
 				break;
 				case SDL_CONTROLLER_BUTTON_BACK:
 					DEBUG(SDL_LOG_CATEGORY_APPLICATION,
 						"Button BACK pressed on instance @%d",
 						event.cbutton.which);
-					switch (SDL_JoystickCurrentPowerLevel(joystick))
+					switch (SDL_JoystickCurrentPowerLevel(
+						SDL_JoystickFromInstanceID(event.cbutton.which)))
 					{
 						case SDL_JOYSTICK_POWER_WIRED:
 							DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Battery status : Wired");
@@ -1,18 +1,27 @@
 #ifndef DEBUG_HPP_INCLUDED
 #define DEBUG_HPP_INCLUDED
 
-#include <map>
+#include "../Graphics/SpriteBatch.hpp"
+#include "../Graphics/SpriteSheet.hpp"
+#include "../System/AssetLoader.hpp"
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/IEventHandler.hpp>
+#include "../Input/IInputHandler.hpp"
+#include <memory>
+
+/* Trigger pressure is drawn in that many steps */
+#define TRIGGER_LEVELS 6
 
 namespace GameControllerDebug
 {
+	class View;
+
 	class Factory
 	{
 		public:
 			static std::shared_ptr<GameContext> createGameControllerDebug(
 				std::shared_ptr<Platform> platform);
+			static AssetLoader::Manifest getAssets(void);
 	};
 
 	class Model : public IModel
@@ -20,12 +29,14 @@ namespace GameControllerDebug
 		private:
 			std::shared_ptr<Platform> _platform;
 
+			/* Follows whichever controller last pressed a button */
+			int _player;
+			Uint32 _buttons;
 			std::pair<Sint16, Sint16> _leftJoystick;
 			std::pair<double, double> _leftPole;
 			std::pair<Sint16, Sint16> _rightJoystick;
 			std::pair<double, double> _rightPole;
 			std::pair<Sint16, Sint16> _triggers;
-			std::map<std::string, bool> _buttons;
 
 		public:
 			Model(std::shared_ptr<Platform> platform);
@@ -37,30 +48,33 @@ namespace GameControllerDebug
 			std::pair<Sint16, Sint16> getRightJoystick(void);
 			std::pair<double, double> getRightPole(void);
 			std::pair<Sint16, Sint16> getTriggers(void);
-			bool getButton(std::string const & button);
-			std::map<std::string, bool> const & getButtons(void) const;
+			bool getButton(SDL_GameControllerButton const button) const;
+			int getPlayer(void) const;
+			void setPlayer(int const player);
 	};
 
-	class KeyboardEventHandler : public IEventHandler
+	class KeyboardEventHandler : public IInputHandler
 	{
 		public:
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class GameControllerEventHandler : public IEventHandler
+	class GameControllerEventHandler : public IInputHandler
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<Model> _model;
+			std::shared_ptr<View> _view;
 
 		public:
 			GameControllerEventHandler(
 				std::shared_ptr<Platform> platform,
-				std::shared_ptr<Model> model);
+				std::shared_ptr<Model> model,
+				std::shared_ptr<View> view);
 			~GameControllerEventHandler(void);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
 	class View : public IView
@@ -69,6 +83,17 @@ namespace GameControllerDebug
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<Model> _model;
 
+			/* Clip handles resolved once : drawing is a single batch */
+			std::unique_ptr<SpriteSheet> _sheet;
+			unsigned int _sheetGeneration;
+			SpriteBatch _batch;
+			int _buttonOn[SDL_CONTROLLER_BUTTON_MAX];
+			int _buttonOff[SDL_CONTROLLER_BUTTON_MAX];
+			int _leftTrigger[TRIGGER_LEVELS];
+			int _rightTrigger[TRIGGER_LEVELS];
+
+			void loadSheet(void);
+
 		public:
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<Model> model);
@@ -5,21 +5,78 @@
 #include <VBN/WindowManager.hpp>
 #include <VBN/Window.hpp>
 #include <VBN/Logging.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Graphics/LogOverlay.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/FreezeFrame.hpp"
+#include "../Graphics/RendererAccess.hpp"
+#include "../System/AssetLoader.hpp"
+#include "../System/LogRing.hpp"
+#include "../System/FrameProfiler.hpp"
+#include "../System/FastLog.hpp"
+#include "../Input/InputService.hpp"
 
 #define LOG_WIDTH 1000
 #define LOG_HEIGHT 400
+#define PROFILER_WIDTH 384
+#define PROFILER_HEIGHT 250
+
+namespace
+{
+	/*
+	 * Batches through a wrapper : events it handles itself split the batch,
+	 * the runs in between go to the sub-handler in one call each.
+	 */
+	void forwardBatch(IInputHandler & wrapper,
+		IInputHandler * subHandler,
+		bool (*isOwnEvent)(Uint32 const),
+		SDL_Event const * events,
+		std::size_t const count,
+		InputContext const & context)
+	{
+		std::size_t first(0);
+
+		for (std::size_t index(0); index < count; ++index)
+		{
+			if (!isOwnEvent(events[index].type))
+				continue;
+
+			if (subHandler && index > first)
+				subHandler->handleInputBatch(events + first, index - first, context);
+			wrapper.handleInput(events[index], context);
+			first = index + 1;
+		}
+
+		if (subHandler && count > first)
+			subHandler->handleInputBatch(events + first, count - first, context);
+	}
+
+	bool isControllerDeviceEvent(Uint32 const eventType)
+	{
+		return eventType == SDL_CONTROLLERDEVICEADDED
+			|| eventType == SDL_CONTROLLERDEVICEREMOVED
+			|| eventType == SDL_CONTROLLERDEVICEREMAPPED;
+	}
+
+	bool isJoystickDeviceEvent(Uint32 const eventType)
+	{
+		return eventType == SDL_JOYDEVICEADDED
+			|| eventType == SDL_JOYDEVICEREMOVED;
+	}
+}
 
 std::shared_ptr<GameContext> Global::Factory::createGlobal(
 	std::shared_ptr<Platform> platform,
 	std::shared_ptr<IModel> subModel,
 	std::shared_ptr<IView> subView,
-	std::shared_ptr<IEventHandler> mouse,
-	std::shared_ptr<IEventHandler> keyboard,
-	std::shared_ptr<IEventHandler> gameController,
-	std::shared_ptr<IEventHandler> joystick,
-	std::shared_ptr<IEventHandler> window)
+	std::shared_ptr<IInputHandler> mouse,
+	std::shared_ptr<IInputHandler> keyboard,
+	std::shared_ptr<IInputHandler> gameController,
+	std::shared_ptr<IInputHandler> joystick,
+	std::shared_ptr<IInputHandler> window)
 {
 	return std::make_shared<GameContext>(
+		platform,
 		subModel,
 		std::make_shared<Global::View>(platform,
 			subView),
@@ -63,8 +120,32 @@ bool Global::Model::getShowLogs(void) const
 Global::View::View(std::shared_ptr<Platform> platform,
 	std::shared_ptr<IView> subView) :
 	_platform(platform),
-	_subView(subView)
-{}
+	_subView(subView),
+	_interpolableSubView(std::dynamic_pointer_cast<IInterpolable>(subView)),
+	_idleSubView(std::dynamic_pointer_cast<IIdle>(subView)),
+	_shownSequence(0)
+{
+	LogRing::getInstance()->install();
+}
+
+void Global::View::setInterpolation(double const alpha)
+{
+	if (_interpolableSubView)
+		_interpolableSubView->setInterpolation(alpha);
+}
+
+/* Static as long as the sub-view is, and no log line or graph has to move */
+Uint32 Global::View::getIdleTime(void) const
+{
+	if (FrameProfiler::isEnabled())
+		return 0;
+
+	if (Model::getInstance()->getShowLogs()
+		&& LogRing::getInstance()->getLastSequence() != _shownSequence)
+		return 0;
+
+	return _idleSubView ? _idleSubView->getIdleTime() : 0;
+}
 
 void Global::View::display(void)
 {
@@ -74,120 +155,269 @@ void Global::View::display(void)
 	renderer->setDrawColor(0, 0, 0, 255);
 	renderer->clear();
 
+	/* Sub-view draws are recorded & sorted, overlays come on top of them */
 	if (_subView)
+	{
+		FrameProfiler::Probe probe(FrameProfiler::SUB_VIEW);
+		std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+
+		commands->begin(getSDLRenderer(mainWindow));
 		_subView->display();
+		commands->flush();
+	}
 
+	std::pair<int, int> winSize = mainWindow->getSize();
 	if (Model::getInstance()->getShowLogs())
 	{
-		std::pair<int, int> winSize = mainWindow->getSize();
-		renderer->printText(Logger::lastLogs(),
-			"courier", 12, { 255, 255, 255, 255 },
+		FrameProfiler::Probe probe(FrameProfiler::LOG_OVERLAY);
+		_shownSequence = LogRing::getInstance()->getLastSequence();
+		LogOverlay::getInstance()->display(mainWindow,
 			{ winSize.first - LOG_WIDTH, winSize.second - LOG_HEIGHT,
 			LOG_WIDTH, LOG_HEIGHT});
 	}
 
-	renderer->present();
+	/* Frame time graph, to the left of the log overlay */
+	if (FrameProfiler::isEnabled())
+		FrameProfiler::getInstance()->display(mainWindow,
+			{ winSize.first - LOG_WIDTH - PROFILER_WIDTH,
+			winSize.second - PROFILER_HEIGHT,
+			PROFILER_WIDTH, PROFILER_HEIGHT });
+
+	{
+		FrameProfiler::Probe probe(FrameProfiler::PRESENT);
+		renderer->present();
+	}
 }
 
 Global::EventHandler::EventHandler(
 	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> mouse,
-	std::shared_ptr<IEventHandler> keyboard,
-	std::shared_ptr<IEventHandler> gameController,
-	std::shared_ptr<IEventHandler> joystick,
-	std::shared_ptr<IEventHandler> window) :
-	EventDispatcher(
-		std::shared_ptr<IEventHandler>(
-			new Global::MouseEventHandler(platform, mouse)),
-		std::shared_ptr<IEventHandler>(
-			new Global::KeyboardEventHandler(platform, keyboard)),
-		std::shared_ptr<IEventHandler>(
-			new Global::GameControllerEventHandler(platform, gameController)),
-		std::shared_ptr<IEventHandler>(
-			new Global::JoystickEventHandler(platform, joystick)),
-		std::shared_ptr<IEventHandler>(
-			new Global::WindowEventHandler(platform, window)))
+	std::shared_ptr<IInputHandler> mouse,
+	std::shared_ptr<IInputHandler> keyboard,
+	std::shared_ptr<IInputHandler> gameController,
+	std::shared_ptr<IInputHandler> joystick,
+	std::shared_ptr<IInputHandler> window) :
+	_platform(platform),
+	_mouse(std::make_shared<Global::MouseEventHandler>(mouse)),
+	_keyboard(std::make_shared<Global::KeyboardEventHandler>(keyboard)),
+	_gameController(std::make_shared<Global::GameControllerEventHandler>(
+		gameController)),
+	_joystick(std::make_shared<Global::JoystickEventHandler>(joystick)),
+	_window(std::make_shared<Global::WindowEventHandler>(window))
 {}
 
+IInputHandler * Global::EventHandler::route(Uint32 const eventType) const
+{
+	switch (eventType)
+	{
+		case SDL_MOUSEMOTION:
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+		case SDL_MOUSEWHEEL:
+			return _mouse.get();
+
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+		case SDL_TEXTEDITING:
+		case SDL_TEXTINPUT:
+			return _keyboard.get();
+
+		case SDL_CONTROLLERAXISMOTION:
+		case SDL_CONTROLLERBUTTONDOWN:
+		case SDL_CONTROLLERBUTTONUP:
+		case SDL_CONTROLLERDEVICEADDED:
+		case SDL_CONTROLLERDEVICEREMOVED:
+		case SDL_CONTROLLERDEVICEREMAPPED:
+			return _gameController.get();
+
+		case SDL_JOYAXISMOTION:
+		case SDL_JOYBALLMOTION:
+		case SDL_JOYHATMOTION:
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+		case SDL_JOYDEVICEADDED:
+		case SDL_JOYDEVICEREMOVED:
+			return _joystick.get();
+
+		case SDL_WINDOWEVENT:
+			return _window.get();
+
+		default:
+			return nullptr;
+	}
+}
+
+void Global::EventHandler::handleRenderReset(SDL_Event const & event)
+{
+	switch (event.type)
+	{
+		/* Render target contents (and on device loss, all textures) are gone */
+		case SDL_RENDER_DEVICE_RESET:
+			AssetLoader::getInstance()->reloadTextures(getSDLRenderer(
+				_platform->getWindowManager()->getWindowByName("mainWindow")));
+			TextCache::getInstance()->clear();
+			LogOverlay::getInstance()->clear();
+			FreezeFrame::invalidateAll();
+		break;
+		case SDL_RENDER_TARGETS_RESET:
+			LogOverlay::getInstance()->invalidate();
+			FreezeFrame::invalidateAll();
+		break;
+	}
+}
+
+void Global::EventHandler::handleEvent(SDL_Event const & event,
+	std::shared_ptr<EngineUpdate> engineUpdate)
+{
+	InputContext const context{ *engineUpdate, *_platform,
+		_platform->getWindowManager()->getWindowByName("mainWindow"), nullptr };
+
+	handleInput(event, context);
+}
+
+void Global::EventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
+{
+	IInputHandler * handler(route(event.type));
+
+	if (handler)
+		handler->handleInput(event, context);
+	else
+		handleRenderReset(event);
+}
+
+/* Consecutive events for the same wrapper go down in one call */
+void Global::EventHandler::handleInputBatch(SDL_Event const * events,
+	std::size_t const count,
+	InputContext const & context)
+{
+	std::size_t first(0);
+
+	while (first < count)
+	{
+		IInputHandler * handler(route(events[first].type));
+		std::size_t last(first + 1);
+
+		while (last < count && route(events[last].type) == handler)
+			++last;
+
+		if (handler)
+			handler->handleInputBatch(events + first, last - first, context);
+		else
+			for (std::size_t index(first); index < last; ++index)
+				handleRenderReset(events[index]);
+
+		first = last;
+	}
+}
+
 Global::KeyboardEventHandler::KeyboardEventHandler(
-	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> subHandler) :
-	_platform(platform),
+	std::shared_ptr<IInputHandler> subHandler) :
 	_subHandler(subHandler)
 {}
 
-void Global::KeyboardEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void Global::KeyboardEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
-	Uint32 keyEvType = event.key.type;
-	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
-
-	switch(event.key.keysym.sym)
+	/* Text events come routed here too : they carry no key */
+	switch (event.type)
 	{
-		case SDLK_F11:
-			if(keyEvType == SDL_KEYDOWN)
-				mainWindow->toggleFullscreen();
+		case SDL_KEYDOWN:
+			switch(event.key.keysym.sym)
+			{
+				case SDLK_F11:
+					if(context.mainWindow)
+						context.mainWindow->toggleFullscreen();
+				break;
+				case SDLK_F12:
+					Model::getInstance()->toggleShowLogs();
+				break;
+				case SDLK_F10:
+					FrameProfiler::getInstance()->toggle();
+				break;
+				case SDLK_F9:
+					CommandBuffer::getInstance()->toggle();
+				break;
+			}
+		break;
+		case SDL_TEXTINPUT:
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
+				"Text input \"%s\"",
+				event.text.text);
 		break;
-		case SDLK_F12:
-			if(keyEvType == SDL_KEYDOWN)
-			Model::getInstance()->toggleShowLogs();
+		case SDL_TEXTEDITING:
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
+				"Text editing \"%s\" @%d+%d",
+				event.edit.text,
+				event.edit.start,
+				event.edit.length);
 		break;
 	}
 
 	if(_subHandler)
-		_subHandler->handleEvent(event, engineUpdate);
+		_subHandler->handleInput(event, context);
 }
 
 Global::MouseEventHandler::MouseEventHandler(
-	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> subHandler) :
-	_platform(platform),
+	std::shared_ptr<IInputHandler> subHandler) :
 	_subHandler(subHandler)
 {}
 
-void Global::MouseEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void Global::MouseEventHandler::logEvent(SDL_Event const & event)
 {
 	switch (event.type)
 	{
-//		case SDL_MOUSEMOTION:
-//			VERBOSE(SDL_LOG_CATEGORY_INPUT,
-//				"Mouse motion (%d, %d)",
-//				event.motion.xrel,
-//				event.motion.yrel);
-//		break;
+		case SDL_MOUSEMOTION:
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
+				"Mouse motion (%d, %d)",
+				event.motion.xrel,
+				event.motion.yrel);
+		break;
 		case SDL_MOUSEBUTTONDOWN:
-			VERBOSE(SDL_LOG_CATEGORY_INPUT,
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
 				"Mouse button %d down @[%d, %d]",
 				event.button.button,
 				event.button.x,
 				event.button.y);
 		break;
 		case SDL_MOUSEBUTTONUP:
-			VERBOSE(SDL_LOG_CATEGORY_INPUT,
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
 				"Mouse button %d up",
 				event.button.button);
 		break;
 		case SDL_MOUSEWHEEL:
-			VERBOSE(SDL_LOG_CATEGORY_INPUT,
+			FAST_VERBOSE(SDL_LOG_CATEGORY_INPUT,
 				"Mouse wheel (%d, %d)",
 				event.wheel.x,
 				event.wheel.y);
 		break;
 	}
+}
+
+void Global::MouseEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
+{
+	logEvent(event);
 	if (_subHandler)
-		_subHandler->handleEvent(event, engineUpdate);
+		_subHandler->handleInput(event, context);
+}
+
+void Global::MouseEventHandler::handleInputBatch(SDL_Event const * events,
+	std::size_t const count,
+	InputContext const & context)
+{
+	for (std::size_t index(0); index < count; ++index)
+		logEvent(events[index]);
+	if (_subHandler)
+		_subHandler->handleInputBatch(events, count, context);
 }
 
 Global::GameControllerEventHandler::GameControllerEventHandler(
-	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> subHandler) :
-	_platform(platform),
+	std::shared_ptr<IInputHandler> subHandler) :
 	_subHandler(subHandler)
 {}
 
-void Global::GameControllerEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void Global::GameControllerEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch(event.type)
 	{
@@ -196,17 +426,19 @@ void Global::GameControllerEventHandler::handleEvent(SDL_Event const & event,
 				"Device #%d added",
 				event.cdevice.which);
 
-			_platform
-				->getGameControllerManager()
+			context.platform
+				.getGameControllerManager()
 				->openFromDeviceIndex(event.cdevice.which);
+			InputService::getInstance()->connectController(event.cdevice.which);
 		break;
 		case SDL_CONTROLLERDEVICEREMOVED:
 			INFO(SDL_LOG_CATEGORY_INPUT,
 				"Instance @%d removed",
 				event.cdevice.which);
 
-			_platform
-				->getGameControllerManager()
+			InputService::getInstance()->disconnectController(event.cdevice.which);
+			context.platform
+				.getGameControllerManager()
 				->closeInstance(event.cdevice.which);
 		break;
 
@@ -218,21 +450,28 @@ void Global::GameControllerEventHandler::handleEvent(SDL_Event const & event,
 
 		default:
 			if (_subHandler)
-				_subHandler->handleEvent(event, engineUpdate);
+				_subHandler->handleInput(event, context);
 		break;
 	}
 }
 
+void Global::GameControllerEventHandler::handleInputBatch(
+	SDL_Event const * events,
+	std::size_t const count,
+	InputContext const & context)
+{
+	forwardBatch(*this, _subHandler.get(), &isControllerDeviceEvent,
+		events, count, context);
+}
+
 Global::JoystickEventHandler::JoystickEventHandler(
-	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> subHandler) :
-	_platform(platform),
+	std::shared_ptr<IInputHandler> subHandler) :
 	_subHandler(subHandler)
 {}
 
-void Global::JoystickEventHandler::handleEvent(
+void Global::JoystickEventHandler::handleInput(
 	SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+	InputContext const & context)
 {
 	switch (event.type)
 	{
@@ -248,28 +487,35 @@ void Global::JoystickEventHandler::handleEvent(
 		break;
 		default:
 			if (_subHandler)
-				_subHandler->handleEvent(event, engineUpdate);
+				_subHandler->handleInput(event, context);
 		break;
 	}
 }
 
+void Global::JoystickEventHandler::handleInputBatch(
+	SDL_Event const * events,
+	std::size_t const count,
+	InputContext const & context)
+{
+	forwardBatch(*this, _subHandler.get(), &isJoystickDeviceEvent,
+		events, count, context);
+}
+
 Global::WindowEventHandler::WindowEventHandler(
-	std::shared_ptr<Platform> platform,
-	std::shared_ptr<IEventHandler> subHandler) :
-	_platform(platform),
+	std::shared_ptr<IInputHandler> subHandler) :
 	_subHandler(subHandler)
 {}
 
-void Global::WindowEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void Global::WindowEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	Window * window(nullptr);
 
 	switch (event.window.event)
 	{
 		case SDL_WINDOWEVENT_SIZE_CHANGED:
-			window = _platform
-				->getWindowManager()
+			window = context.platform
+				.getWindowManager()
 				->getWindowById(event.window.windowID);
 
 			DEBUG(SDL_LOG_CATEGORY_APPLICATION,
@@ -282,7 +528,7 @@ void Global::WindowEventHandler::handleEvent(SDL_Event const & event,
 		break;
 		default:
 			if (_subHandler)
-				_subHandler->handleEvent(event, engineUpdate);
+				_subHandler->handleInput(event, context);
 		break;
 	}
-}
\ No newline at end of file
+}
@@ -3,7 +3,10 @@
 
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/EventDispatcher.hpp>
+#include <VBN/IEventHandler.hpp>
+#include "../Graphics/IInterpolable.hpp"
+#include "../Input/IInputHandler.hpp"
+#include "../System/IIdle.hpp"
 
 class Platform;
 
@@ -16,11 +19,11 @@ namespace Global
 				std::shared_ptr<Platform> platform,
 				std::shared_ptr<IModel> subModel,
 				std::shared_ptr<IView> subView,
-				std::shared_ptr<IEventHandler> mouse,
-				std::shared_ptr<IEventHandler> keyboard,
-				std::shared_ptr<IEventHandler> gameController,
-				std::shared_ptr<IEventHandler> joystick,
-				std::shared_ptr<IEventHandler> window);
+				std::shared_ptr<IInputHandler> mouse,
+				std::shared_ptr<IInputHandler> keyboard,
+				std::shared_ptr<IInputHandler> gameController,
+				std::shared_ptr<IInputHandler> joystick,
+				std::shared_ptr<IInputHandler> window);
 	};
 
 	class Model : public IModel
@@ -39,95 +42,124 @@ namespace Global
 			bool getShowLogs(void) const;
 	};
 
-	class View : public IView
+	class View : public IView, public IInterpolable, public IIdle
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<IView> _subView;
+			std::shared_ptr<IInterpolable> _interpolableSubView;
+			std::shared_ptr<IIdle> _idleSubView;
+			Uint64 _shownSequence;
 
 		public:
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<IView> subView);
 			void display(void);
+			void setInterpolation(double const alpha);
+			Uint32 getIdleTime(void) const;
 	};
 
-	class EventHandler : public EventDispatcher
+	/*
+	 * Routes each event to one of the wrappers below by type. Still an
+	 * IEventHandler for VBN callers, which pay for a context lookup per event.
+	 */
+	class EventHandler : public IEventHandler, public IInputHandler
 	{
+		private:
+			std::shared_ptr<Platform> _platform;
+			std::shared_ptr<IInputHandler> _mouse;
+			std::shared_ptr<IInputHandler> _keyboard;
+			std::shared_ptr<IInputHandler> _gameController;
+			std::shared_ptr<IInputHandler> _joystick;
+			std::shared_ptr<IInputHandler> _window;
+
+			IInputHandler * route(Uint32 const eventType) const;
+			void handleRenderReset(SDL_Event const & event);
+
 		public:
 			EventHandler(
 				std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> mouse,
-				std::shared_ptr<IEventHandler> keyboard,
-				std::shared_ptr<IEventHandler> gameController,
-				std::shared_ptr<IEventHandler> joystick,
-				std::shared_ptr<IEventHandler> window);
+				std::shared_ptr<IInputHandler> mouse,
+				std::shared_ptr<IInputHandler> keyboard,
+				std::shared_ptr<IInputHandler> gameController,
+				std::shared_ptr<IInputHandler> joystick,
+				std::shared_ptr<IInputHandler> window);
+
+			void handleEvent(SDL_Event const & event,
+				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
+			void handleInputBatch(SDL_Event const * events,
+				std::size_t const count,
+				InputContext const & context);
 	};
 
-	class MouseEventHandler : public IEventHandler
+	class MouseEventHandler : public IInputHandler
 	{
 		private:
-			std::shared_ptr<Platform> _platform;
-			std::shared_ptr<IEventHandler> _subHandler;
+			std::shared_ptr<IInputHandler> _subHandler;
+
+			static void logEvent(SDL_Event const & event);
 
 		public:
-			MouseEventHandler(std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> subHandler);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			MouseEventHandler(std::shared_ptr<IInputHandler> subHandler);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
+			void handleInputBatch(SDL_Event const * events,
+				std::size_t const count,
+				InputContext const & context);
 	};
 
-	class KeyboardEventHandler : public IEventHandler
+	class KeyboardEventHandler : public IInputHandler
 	{
 		private:
-			std::shared_ptr<Platform> _platform;
-			std::shared_ptr<IEventHandler> _subHandler;
+			std::shared_ptr<IInputHandler> _subHandler;
 
 		public:
-			KeyboardEventHandler(std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> subHandler);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			KeyboardEventHandler(std::shared_ptr<IInputHandler> subHandler);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class GameControllerEventHandler : public IEventHandler
+	class GameControllerEventHandler : public IInputHandler
 	{
 		private:
-			std::shared_ptr<Platform> _platform;
-			std::shared_ptr<IEventHandler> _subHandler;
+			std::shared_ptr<IInputHandler> _subHandler;
 
 		public:
-			GameControllerEventHandler(std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> subHandler);
+			GameControllerEventHandler(std::shared_ptr<IInputHandler> subHandler);
 
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
+			void handleInputBatch(SDL_Event const * events,
+				std::size_t const count,
+				InputContext const & context);
 	};
 
-	class JoystickEventHandler : public IEventHandler
+	class JoystickEventHandler : public IInputHandler
 	{
 		private:
-			std::shared_ptr<Platform> _platform;
-			std::shared_ptr<IEventHandler> _subHandler;
+			std::shared_ptr<IInputHandler> _subHandler;
 
 		public:
-			JoystickEventHandler(std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> subHandler);
+			JoystickEventHandler(std::shared_ptr<IInputHandler> subHandler);
 
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
+			void handleInputBatch(SDL_Event const * events,
+				std::size_t const count,
+				InputContext const & context);
 	};
 
-	class WindowEventHandler : public IEventHandler
+	class WindowEventHandler : public IInputHandler
 	{
 		private:
-			std::shared_ptr<Platform> _platform;
-			std::shared_ptr<IEventHandler> _subHandler;
+			std::shared_ptr<IInputHandler> _subHandler;
 
 		public:
-			WindowEventHandler(std::shared_ptr<Platform> platform,
-				std::shared_ptr<IEventHandler> subHandler);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			WindowEventHandler(std::shared_ptr<IInputHandler> subHandler);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 };
 
@@ -0,0 +1,100 @@
+#include "Loading.hpp"
+#include "Global.hpp"
+#include <VBN/Platform.hpp>
+#include <VBN/EngineUpdate.hpp>
+#include <VBN/WindowManager.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
+
+/* ----------------- FACTORY ----------------- */
+std::shared_ptr<GameContext> Loading::Factory::createLoading(
+	std::shared_ptr<Platform> platform,
+	AssetLoader::Manifest const & manifest,
+	Target target)
+{
+	std::shared_ptr<AssetLoader> loader(AssetLoader::getInstance());
+
+	loader->request(manifest);
+	if (loader->isDone(manifest))
+		return target(platform);
+
+	std::shared_ptr<Loading::Model> model(
+		std::make_shared<Loading::Model>(platform, manifest, target));
+
+	return Global::Factory::createGlobal(
+		platform,
+		model,
+		std::make_shared<Loading::View>(platform, model),
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr);
+}
+
+/* ------------------ MODEL ------------------ */
+Loading::Model::Model(std::shared_ptr<Platform> platform,
+	AssetLoader::Manifest const & manifest,
+	Target target) :
+	_platform(platform),
+	_manifest(manifest),
+	_target(target),
+	_launched(false)
+{}
+
+void Loading::Model::elapse(Uint32 const gameTicks,
+	std::shared_ptr<EngineUpdate> engineUpdate)
+{
+	/* Back on top : the target activity is over */
+	if (_launched)
+	{
+		engineUpdate->popGameContext();
+		return;
+	}
+
+	std::shared_ptr<AssetLoader> loader(AssetLoader::getInstance());
+	loader->update(getSDLRenderer(
+		_platform->getWindowManager()->getWindowByName("mainWindow")));
+
+	if (loader->isDone(_manifest))
+	{
+		engineUpdate->pushGameContext(_target(_platform));
+		_launched = true;
+	}
+}
+
+double Loading::Model::getProgress(void) const
+{
+	return AssetLoader::getInstance()->getProgress(_manifest);
+}
+
+/* ------------------ VIEW ------------------ */
+Loading::View::View(std::shared_ptr<Platform> platform,
+	std::shared_ptr<Model> model) :
+	_platform(platform),
+	_model(model)
+{}
+
+void Loading::View::display(void)
+{
+	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
+	SDL_Renderer * renderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+
+	SDL_Rect const bar{ 400, 430, 800, 40 };
+	SDL_Rect filled(bar);
+	filled.w = static_cast<int>(bar.w * _model->getProgress());
+
+	commands->setLayer(LAYER_BACKGROUND);
+	commands->fill(renderer, { 0, 0, 0, 255 });
+
+	commands->setLayer(LAYER_SHAPES);
+	commands->fillRect(renderer, { 0, 0, 150, 255 }, filled);
+	commands->drawRect(renderer, { 192, 192, 192, 255 }, bar);
+
+	commands->setLayer(LAYER_TEXT);
+	TextCache::getInstance()->printText(mainWindow,
+		"Loading...", "courier", 20, { 192, 192, 192, 255 },
+		{ bar.x, bar.y - 40, bar.w, 32 });
+}
@@ -0,0 +1,61 @@
+#ifndef LOADING_HPP_INCLUDED
+#define LOADING_HPP_INCLUDED
+
+#include "../GameContext.hpp"
+#include "../System/AssetLoader.hpp"
+#include <VBN/IModel.hpp>
+#include <VBN/IView.hpp>
+#include <functional>
+
+/*
+ * Shows loading progress while the AssetLoader makes an activity's assets
+ * resident, then pushes that activity. Once the activity is popped, the
+ * loading context pops itself too.
+ */
+namespace Loading
+{
+	typedef std::function<std::shared_ptr<GameContext>(
+		std::shared_ptr<Platform>)> Target;
+
+	class Factory
+	{
+		public:
+			/* Returns the target itself if its assets are already resident */
+			static std::shared_ptr<GameContext> createLoading(
+				std::shared_ptr<Platform> platform,
+				AssetLoader::Manifest const & manifest,
+				Target target);
+	};
+
+	class Model : public IModel
+	{
+		private:
+			std::shared_ptr<Platform> _platform;
+			AssetLoader::Manifest _manifest;
+			Target _target;
+			bool _launched;
+
+		public:
+			Model(std::shared_ptr<Platform> platform,
+				AssetLoader::Manifest const & manifest,
+				Target target);
+			void elapse(Uint32 const gameTicks,
+				std::shared_ptr<EngineUpdate> engineUpdate);
+
+			double getProgress(void) const;
+	};
+
+	class View : public IView
+	{
+		private:
+			std::shared_ptr<Platform> _platform;
+			std::shared_ptr<Model> _model;
+
+		public:
+			View(std::shared_ptr<Platform> platform,
+				std::shared_ptr<Model> model);
+			void display(void);
+	};
+};
+
+#endif // LOADING_HPP_INCLUDED
@@ -3,10 +3,13 @@
 #include "TextDebug.hpp"
 #include "GameControllerDebug.hpp"
 #include "Tank.hpp"
+#include "Loading.hpp"
 #include <VBN/WindowManager.hpp>
 #include <VBN/EngineUpdate.hpp>
 #include <VBN/Platform.hpp>
-#include <VBN/Mixer.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
 
 /* ----------------- FACTORY ----------------- */
 std::shared_ptr<GameContext> Menu::Factory::createMenu(
@@ -17,7 +20,7 @@ std::shared_ptr<GameContext> Menu::Factory::createMenu(
 	std::shared_ptr<Menu::Controller> menuController(
 		new Menu::Controller(platform, model));
 
-	return Global::Factory::createGlobal(
+	std::shared_ptr<GameContext> context(Global::Factory::createGlobal(
 		platform,
 		model,
 		std::make_shared<Menu::View>(platform, model),
@@ -25,7 +28,20 @@ std::shared_ptr<GameContext> Menu::Factory::createMenu(
 		menuController,
 		menuController,
 		nullptr,
-		nullptr);
+		nullptr));
+
+	context->setMaxUpdateRate(MENU_UPDATE_RATE);
+	context->setCoalescing(true);
+
+	return context;
+}
+
+AssetLoader::Manifest Menu::Factory::getAssets(void)
+{
+	return {
+		{ AssetLoader::FONT, "courier", "assets/fonts/courier.ttf" },
+		{ AssetLoader::SAMPLE, "drum", "assets/audio/sample.wav" },
+		{ AssetLoader::MUSIC, "ftl", "assets/audio/music.flac" } };
 }
 
 /* ------------------ MODEL ------------------ */
@@ -40,7 +56,8 @@ Menu::Model::Model(void) :
 	_backgroundColor{0, 0, 0, 255},
 	_textColor{192, 192, 192, 255},
 	_selectionColor{0, 0, 150, 255},
-	_ascend(true)
+	_ascend(true),
+	_pulseTicks(0)
 {}
 
 Menu::Model::Item Menu::Model::getCurrentSelection(void)
@@ -73,18 +90,39 @@ void Menu::Model::cycleTo(Item const app)
 void Menu::Model::elapse(Uint32 const gameTicks,
 	std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	if (_ascend && _selectionColor.b < 200)
+	/* Ticks short of a step carry over, whatever the update rate */
+	_pulseTicks += gameTicks;
+
+	int blue(_selectionColor.b);
+	int step(static_cast<int>(_pulseTicks / MENU_PULSE_STEP));
+	_pulseTicks %= MENU_PULSE_STEP;
+
+	if (_ascend)
 	{
-		_selectionColor.b += 4;
-		if (_selectionColor.b >= 200)
+		blue += step;
+		if (blue >= 200)
+		{
+			blue = 200;
 			_ascend = false;
+		}
 	}
-	else if (!_ascend && _selectionColor.b > 50)
+	else
 	{
-		_selectionColor.b -= 4;
-		if (_selectionColor.b <= 50)
+		blue -= step;
+		if (blue <= 50)
+		{
+			blue = 50;
 			_ascend = true;
+		}
 	}
+
+	_selectionColor.b = static_cast<Uint8>(blue);
+}
+
+Uint32 Menu::Model::getIdleTime(void) const
+{
+	/* The pulse never settles : only its next step is a deadline */
+	return MENU_PULSE_STEP - _pulseTicks;
 }
 
 SDL_Color Menu::Model::getBackgroundColor(void)
@@ -111,41 +149,50 @@ Menu::Controller::Controller(
 	_model(model)
 {}
 
-void Menu::Controller::performAction(std::shared_ptr<EngineUpdate> engineUpdate)
+void Menu::Controller::performAction(EngineUpdate & engineUpdate)
 {
 	switch(_model->getCurrentSelection())
 	{
 		case Model::APP_1:
-			engineUpdate->pushGameContext(
-				Tank::Factory::createGameControllerDebug(
-					_platform));
+			engineUpdate.pushGameContext(
+				Loading::Factory::createLoading(
+					_platform,
+					Tank::Factory::getAssets(),
+					&Tank::Factory::createGameControllerDebug));
 		break;
 		case Model::APP_2:
-			engineUpdate->pushGameContext(
-				GameControllerDebug::Factory::createGameControllerDebug(
-					_platform));
+			engineUpdate.pushGameContext(
+				Loading::Factory::createLoading(
+					_platform,
+					GameControllerDebug::Factory::getAssets(),
+					&GameControllerDebug::Factory::createGameControllerDebug));
 		break;
 		case Model::APP_3:
-			engineUpdate->pushGameContext(
+			engineUpdate.pushGameContext(
 				TextDebug::Factory::createTextDebug(
 					_platform));
 		break;
 		case Model::APP_4:
+			engineUpdate.pushGameContext(
+				Loading::Factory::createLoading(
+					_platform,
+					Tank::Factory::getAssets(),
+					&Tank::Factory::createSwarm));
 		break;
 		case Model::EXIT:
-			engineUpdate->popGameContext();
+			engineUpdate.popGameContext();
 		break;
 	}
 }
 
-void Menu::Controller::quickExit(std::shared_ptr<EngineUpdate> engineUpdate)
+void Menu::Controller::quickExit(EngineUpdate & engineUpdate)
 {
 	_model->setCurrentSelection(Model::EXIT);
 	performAction(engineUpdate);
 }
 
-void Menu::Controller::handleEvent(SDL_Event const & event,
-							std::shared_ptr<EngineUpdate> engineUpdate)
+void Menu::Controller::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch(event.type)
 	{
@@ -154,19 +201,19 @@ void Menu::Controller::handleEvent(SDL_Event const & event,
 			{
 				case SDLK_UP:
 					_model->cycleUp();
-					_platform->getMixer()->playEffect("drum");
+					AssetLoader::getInstance()->playEffect("drum");
 				break;
 				case SDLK_DOWN:
 					_model->cycleDown();
-					_platform->getMixer()->playEffect("drum");
+					AssetLoader::getInstance()->playEffect("drum");
 				break;
 
 				case SDLK_RETURN:
-					performAction(engineUpdate);
+					performAction(context.engineUpdate);
 				break;
 
 				case SDLK_ESCAPE:
-					quickExit(engineUpdate);
+					quickExit(context.engineUpdate);
 				break;
 
 				case SDLK_a:
@@ -186,7 +233,7 @@ void Menu::Controller::handleEvent(SDL_Event const & event,
 				break;
 
 				case SDLK_m:
-					_platform->getMixer()->playMusic("ftl");
+					AssetLoader::getInstance()->playMusic("ftl");
 				break;
 			}
 		break;
@@ -195,17 +242,17 @@ void Menu::Controller::handleEvent(SDL_Event const & event,
 			{
 				case SDL_CONTROLLER_BUTTON_DPAD_DOWN:
 					_model->cycleDown();
-					_platform->getMixer()->playEffect("drum");
+					AssetLoader::getInstance()->playEffect("drum");
 				break;
 				case SDL_CONTROLLER_BUTTON_DPAD_UP:
 					_model->cycleUp();
-					_platform->getMixer()->playEffect("drum");
+					AssetLoader::getInstance()->playEffect("drum");
 				break;
 				case SDL_CONTROLLER_BUTTON_A:
-					performAction(engineUpdate);
+					performAction(context.engineUpdate);
 				break;
 				case SDL_CONTROLLER_BUTTON_BACK:
-					quickExit(engineUpdate);
+					quickExit(context.engineUpdate);
 				break;
 			}
 		break;
@@ -220,6 +267,12 @@ Menu::View::View(std::shared_ptr<Platform> platform,
 	_platform(platform)
 {}
 
+/* Everything drawn comes from the model */
+Uint32 Menu::View::getIdleTime(void) const
+{
+	return IDLE_FOREVER;
+}
+
 void Menu::View::display(void)
 {
 	WindowManager * windowManager(nullptr);
@@ -234,12 +287,17 @@ void Menu::View::display(void)
 	if (!renderer)
 		return;
 
+	SDL_Renderer * sdlRenderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+
 	/* Clear draw area with blue */
-	renderer->setDrawColor(_model->getBackgroundColor());
-	renderer->fill();
+	commands->setLayer(LAYER_BACKGROUND);
+	commands->fill(sdlRenderer, _model->getBackgroundColor());
 
 	/* Print menu name */
-	renderer->printText(
+	std::shared_ptr<TextCache> text(TextCache::getInstance());
+	commands->setLayer(LAYER_TEXT);
+	text->printText(mainWindow,
 		"Main Menu",
 		"courier",
 		20,
@@ -254,31 +312,31 @@ void Menu::View::display(void)
 	menuItems[4] = { 220, 260, 600, 32 };
 
 	/* Print menu items */
-	mainWindow->getRenderer()->printText(
+	text->printText(mainWindow,
 		"A - New Game",
 		"courier",
 		20,
 		_model->getTextColor(),
 		menuItems[0]);
-	mainWindow->getRenderer()->printText(
+	text->printText(mainWindow,
 		"B - Game Controller Debug",
 		"courier",
 		20,
 		_model->getTextColor(),
 		menuItems[1]);
-	mainWindow->getRenderer()->printText(
+	text->printText(mainWindow,
 		"C - Text Display Debug",
 		"courier",
 		20,
 		_model->getTextColor(),
 		menuItems[2]);
-	mainWindow->getRenderer()->printText(
-		"D - <EMPTY>",
+	text->printText(mainWindow,
+		"D - Tank Swarm",
 		"courier",
 		20,
 		_model->getTextColor(),
 		menuItems[3]);
-	mainWindow->getRenderer()->printText(
+	text->printText(mainWindow,
 		"Esc - Exit",
 		"courier",
 		20,
@@ -286,12 +344,7 @@ void Menu::View::display(void)
 		menuItems[4]);
 
 	/* Highlight selection */
-	renderer->setDrawColor(
-		_model->getSelectionColor().r,
-		_model->getSelectionColor().g,
-		_model->getSelectionColor().b,
-		_model->getSelectionColor().a);
-
 	SDL_Rect r(menuItems[_model->getCurrentSelection()]);
-	renderer->drawRect(r);
+	commands->setLayer(LAYER_SHAPES);
+	commands->drawRect(sdlRenderer, _model->getSelectionColor(), r);
 }
@@ -4,11 +4,19 @@
 #include "../GameContext.hpp"
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/IEventHandler.hpp>
+#include "../Input/IInputHandler.hpp"
+#include "../System/IIdle.hpp"
+#include "../System/AssetLoader.hpp"
 #include <array>
 
 #define NB_MENU_ENTRIES 5
 
+/* The menu only animates its selection pulse, which looks fine at 20 Hz */
+#define MENU_UPDATE_RATE 20
+
+/* The selection pulse moves by 1 blue level every that many game ticks */
+#define MENU_PULSE_STEP 4
+
 class WindowManager;
 
 namespace Menu
@@ -18,9 +26,10 @@ namespace Menu
 		public:
 			static std::shared_ptr<GameContext> createMenu(
 				std::shared_ptr<Platform> platform);
+			static AssetLoader::Manifest getAssets(void);
 	};
 
-	class Model : public IModel
+	class Model : public IModel, public IIdle
 	{
 		public:
 			enum Item
@@ -39,6 +48,7 @@ namespace Menu
 			SDL_Color _textColor;
 			SDL_Color _selectionColor;
 			bool _ascend;
+			Uint32 _pulseTicks;
 
 		public:
 			Model(void);
@@ -51,9 +61,10 @@ namespace Menu
 			SDL_Color getTextColor(void);
 			SDL_Color getSelectionColor(void);
 			void elapse(Uint32 const, std::shared_ptr<EngineUpdate>);
+			Uint32 getIdleTime(void) const;
 	};
 
-	class View : public IView
+	class View : public IView, public IIdle
 	{
 		private:
 			std::shared_ptr<Model> _model;
@@ -63,22 +74,23 @@ namespace Menu
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<Model> data);
 			void display(void);
+			Uint32 getIdleTime(void) const;
 	};
 
-	class Controller : public IEventHandler
+	class Controller : public IInputHandler
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<Model> _model;
 
-			void performAction(std::shared_ptr<EngineUpdate> engineUpdate);
-			void quickExit(std::shared_ptr<EngineUpdate> engineUpdate);
+			void performAction(EngineUpdate & engineUpdate);
+			void quickExit(EngineUpdate & engineUpdate);
 
 		public:
 			Controller(std::shared_ptr<Platform> platform,
 						std::shared_ptr<Model> model);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 };
 
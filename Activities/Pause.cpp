@@ -3,14 +3,18 @@
 #include <VBN/Platform.hpp>
 #include <VBN/EngineUpdate.hpp>
 #include <VBN/WindowManager.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
 
 std::shared_ptr<GameContext> Pause::Factory::createPause(
 	std::shared_ptr<Platform> platform,
+	std::weak_ptr<GameContext> paused,
 	std::shared_ptr<IView> subView)
 {
 	return Global::Factory::createGlobal(
 		platform,
-		nullptr,
+		std::make_shared<Pause::Model>(paused),
 		std::make_shared<Pause::View>(
 			platform,
 			subView),
@@ -21,31 +25,84 @@ std::shared_ptr<GameContext> Pause::Factory::createPause(
 		nullptr);
 }
 
+Pause::Model::Model(std::weak_ptr<GameContext> paused) :
+	_paused(paused),
+	_pausedRate(0)
+{
+	std::shared_ptr<GameContext> context(_paused.lock());
+
+	if (context)
+	{
+		_pausedRate = context->getMaxUpdateRate();
+		context->setMaxUpdateRate(0);
+	}
+}
+
+Pause::Model::~Model(void)
+{
+	std::shared_ptr<GameContext> context(_paused.lock());
+
+	if (context)
+		context->setMaxUpdateRate(_pausedRate);
+}
+
+void Pause::Model::elapse(Uint32 const, std::shared_ptr<EngineUpdate>)
+{}
+
+/* Nothing to update : the pause never asks for a redraw on its own */
+Uint32 Pause::Model::getIdleTime(void) const
+{
+	return IDLE_FOREVER;
+}
+
 Pause::View::View(std::shared_ptr<Platform> platform,
 	std::shared_ptr<IView> background) :
 	_platform(platform),
 	_background(background)
 {}
 
+/* The paused context's model is held at 0 Hz : its view is frozen too */
+Uint32 Pause::View::getIdleTime(void) const
+{
+	return IDLE_FOREVER;
+}
+
 void Pause::View::display(void)
 {
 	Window * mainWindow = _platform->getWindowManager()->getWindowByName("mainWindow");
-	Renderer * renderer(mainWindow->getRenderer());
+	SDL_Renderer * renderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	SDL_Color const dim{ 0, 0, 0, 100 };
+
+	/* The paused view is drawn & darkened once, then blitted */
+	bool const frozen(_freezeFrame.isValid(renderer)
+		|| _freezeFrame.capture(renderer, *_background, dim));
 
-	_background->display();
+	if (frozen)
+	{
+		commands->setLayer(LAYER_BACKGROUND);
+		_freezeFrame.display(renderer);
+	}
+	else
+		_background->display();
 
-	renderer->setDrawColor(0, 0, 0, 100);
-	renderer->fill();
+	/* Dim & caption stay above whatever layers the background used */
+	commands->pushLayer();
+	commands->setLayer(LAYER_BACKGROUND);
+	if (!frozen)
+		commands->fill(renderer, dim);
 
-	mainWindow->getRenderer()->printText(
+	commands->setLayer(LAYER_TEXT);
+	TextCache::getInstance()->printText(mainWindow,
 		"PAUSE",
 		"courier", 40,
 		{ 255, 255, 255, 255 },
 		{230, 220, 250, 50});
+	commands->popLayer();
 }
 
-void Pause::GameControllerEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> update)
+void Pause::GameControllerEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch (event.type)
 	{
@@ -53,7 +110,7 @@ void Pause::GameControllerEventHandler::handleEvent(SDL_Event const & event,
 			switch (event.cbutton.button)
 			{
 				case SDL_CONTROLLER_BUTTON_START:
-					update->popGameContext();
+					context.engineUpdate.popGameContext();
 				break;
 			}
 		break;
@@ -4,35 +4,59 @@
 #include "../GameContext.hpp"
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/IEventHandler.hpp>
+#include "../Input/IInputHandler.hpp"
+#include "../System/IIdle.hpp"
+#include "../Graphics/FreezeFrame.hpp"
 
 namespace Pause
 {
 	class Factory
 	{
 		public:
+			/* <paused> updates at 0 Hz until the pause is left */
 			static std::shared_ptr<GameContext> createPause(
 				std::shared_ptr<Platform> platform,
+				std::weak_ptr<GameContext> paused,
 				std::shared_ptr<IView> subView);
 	};
 
-	class GameControllerEventHandler : public IEventHandler
+	/*
+	 * Holds the paused context at 0 Hz for as long as the pause exists :
+	 * however the pause is left, its rate is restored with the pause.
+	 */
+	class Model : public IModel, public IIdle
+	{
+		private:
+			std::weak_ptr<GameContext> _paused;
+			Uint32 _pausedRate;
+
+		public:
+			Model(std::weak_ptr<GameContext> paused);
+			~Model(void);
+			void elapse(Uint32 const gameTicks,
+				std::shared_ptr<EngineUpdate> engineUpdate);
+			Uint32 getIdleTime(void) const;
+	};
+
+	class GameControllerEventHandler : public IInputHandler
 	{
 		public:
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> update);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class View : public IView
+	class View : public IView, public IIdle
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<IView> _background;
+			FreezeFrame _freezeFrame;
 
 		public:
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<IView> background);
 			void display(void);
+			Uint32 getIdleTime(void) const;
 	};
 };
 
@@ -4,14 +4,47 @@
 #include "../GameContext.hpp"
 #include "Tank.hpp"
 #include "Global.hpp"
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Input/InputService.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
+#include "../System/FastLog.hpp"
+#include "../System/JobSystem.hpp"
+#include <algorithm>
 #include <cmath>
 
+#define TANK_TEXTURE "tank"
+#define TANK_TEXTURE_PATH "assets/textures/tank.png"
+
 std::shared_ptr<GameContext> Tank::Factory::createGameControllerDebug(
 	std::shared_ptr<Platform> platform)
 {
 	std::shared_ptr<Tank::Model> model(std::make_shared<Tank::Model>(platform));
+	std::shared_ptr<GameContext> context(Global::Factory::createGlobal(
+		platform,
+		model,
+		std::make_shared<Tank::View>(platform, model),
+		nullptr,
+		std::make_shared<Tank::KeyboardEventHandler>(),
+		std::make_shared<Tank::GameControllerEventHandler>(platform, model),
+		nullptr,
+		nullptr));
+
+	/* Movement must not depend on the display frame rate */
+	context->setFixedRate(TANK_SIMULATION_RATE);
 
-	return Global::Factory::createGlobal(
+	/* Sticks are polled by the model : axis events are only noise here */
+	context->setCoalescing(true);
+
+	return context;
+}
+
+std::shared_ptr<GameContext> Tank::Factory::createSwarm(
+	std::shared_ptr<Platform> platform)
+{
+	std::shared_ptr<Tank::Model> model(std::make_shared<Tank::Model>(platform,
+		TANK_SWARM_SIZE));
+	std::shared_ptr<GameContext> context(Global::Factory::createGlobal(
 		platform,
 		model,
 		std::make_shared<Tank::View>(platform, model),
@@ -19,35 +52,49 @@ std::shared_ptr<GameContext> Tank::Factory::createGameControllerDebug(
 		std::make_shared<Tank::KeyboardEventHandler>(),
 		std::make_shared<Tank::GameControllerEventHandler>(platform, model),
 		nullptr,
-		nullptr);
+		nullptr));
+
+	context->setFixedRate(TANK_SIMULATION_RATE);
+	context->setCoalescing(true);
+
+	return context;
+}
+
+/* The loose image is what the view falls back to when no atlas was built */
+AssetLoader::Manifest Tank::Factory::getAssets(void)
+{
+	AssetLoader::Manifest manifest(SpriteSheet::getAtlasAssets());
+
+	manifest.push_back({ AssetLoader::IMAGE, TANK_TEXTURE, TANK_TEXTURE_PATH });
+
+	return manifest;
 }
 
-Tank::Model::Model(std::shared_ptr<Platform> platform) :
+Tank::Model::Model(std::shared_ptr<Platform> platform,
+	std::size_t const aiTanks,
+	double const arenaWidth,
+	double const arenaHeight) :
 	_platform(platform),
-	_x(500), _y(200),
-	_deltaX(0), _deltaY(0),
-	_dir(0)
-{}
+	_hash(TANK_CELL_SIZE),
+	_arenaWidth(arenaWidth),
+	_arenaHeight(arenaHeight)
+{
+	_tanks.add(500, 200, 0, TANK_PLAYER_RADIUS);
+	_tanks.spawn(aiTanks, _arenaWidth, _arenaHeight, TANK_SWARM_RADIUS);
+}
 
 void Tank::Model::elapse(Uint32 const gameTicks,
 	std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	GameControllerManager * gameControllerManager(nullptr);
-	GameController * gameController(nullptr);
-	SDL_GameController * sdlController(nullptr);
-
-	gameControllerManager = _platform->getGameControllerManager();
-	if(gameControllerManager)
-		gameController = gameControllerManager->getControllerFromDeviceID(0);
-	if(gameController)
-		sdlController = gameController->getSDLGameController();
+	InputSnapshot const & input(InputService::getInstance()->getSnapshot());
 
 	int leftJ(0), rightJ(0);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
 
-	if (sdlController)
+	if (input.isConnected(TANK_PLAYER))
 	{
-		leftJ = SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_LEFTY) / 256;
-		rightJ = SDL_GameControllerGetAxis(sdlController, SDL_CONTROLLER_AXIS_RIGHTY) / 256;
+		leftJ = input.getAxis(TANK_PLAYER, SDL_CONTROLLER_AXIS_LEFTY) / 256;
+		rightJ = input.getAxis(TANK_PLAYER, SDL_CONTROLLER_AXIS_RIGHTY) / 256;
 	}
 	double accel = -leftJ/2 + -rightJ/2;
 
@@ -56,63 +103,156 @@ void Tank::Model::elapse(Uint32 const gameTicks,
 	else
 		accel -= (fabs(accel) / accel) * 10;
 
-	double deltaAngle = rightJ / 30 - leftJ / 30;
-	_dir = fmod(_dir + deltaAngle, 360.f);
+	_tanks.throttle[0] = accel;
+	_tanks.turn[0] = rightJ / 30 - leftJ / 30;
+
+	/* Per-tank passes across cores ; the player's tank is not steered */
+	_boxes.resize(_tanks.size());
+	JobSystem::getInstance()->parallelFor(_tanks.size(), TANK_JOB_GRAIN,
+		[this, gameTicks, scale](std::size_t const first, std::size_t const last)
+		{
+			_tanks.steer(gameTicks, std::max<std::size_t>(first, 1), last,
+				_arenaWidth, _arenaHeight);
+			_tanks.integrate(scale, first, last);
+			_tanks.sweep(_boxes, first, last);
+		});
+
+	/* Against each other over the whole step, then against the arena */
+	_hash.build(_boxes);
+	_hash.findPairs(_pairs);
+	_tanks.resolve(_pairs, 1);
+	_tanks.confine(_arenaWidth, _arenaHeight);
 
-	VERBOSE(SDL_LOG_CATEGORY_APPLICATION,
+	FAST_VERBOSE(SDL_LOG_CATEGORY_APPLICATION,
 		"[ %f, %f] - [ %f, %f ] - [ T : %f ] - [ dT : %f ] - [ v : %f ]",
-		_x, _y,
-		_deltaX, _deltaY,
-		_dir,
-		deltaAngle, accel);
-
-	_deltaX = accel/20 * cos(_dir * (M_PI / 180.f));
-	_deltaY = accel/20 * sin(_dir * (M_PI / 180.f));
-	_x += _deltaX;
-	_y += _deltaY;
+		_tanks.x[0], _tanks.y[0],
+		_tanks.deltaX[0], _tanks.deltaY[0],
+		_tanks.dir[0],
+		_tanks.turn[0], accel);
+}
+
+Tank::Store const & Tank::Model::getTanks(void) const
+{
+	return _tanks;
 }
 
 Tank::View::View(
 	std::shared_ptr<Platform> platform,
 	std::shared_ptr<Model> model) :
 	_platform(platform),
-	_model(model)
+	_model(model),
+	_alpha(1.),
+	_sheetGeneration(0),
+	_tankClip(-1),
+	_visible(0),
+	_culled(0)
+{
+	loadSheet();
+}
+
+/* Again when the device was lost : the sheet's texture went with it */
+void Tank::View::loadSheet(void)
 {
 	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
-	Renderer * renderer(nullptr);
-	if (mainWindow)
-		renderer = mainWindow->getRenderer();
+	std::shared_ptr<AssetLoader> loader(AssetLoader::getInstance());
 
-	if (renderer && !renderer->getTexture("TANK"))
+	/*
+	 * Pushed without a loading screen : load the assets here. No atlas
+	 * built : the loose image, if any.
+	 */
+	loader->load(getSDLRenderer(mainWindow), Factory::getAssets());
+	_sheetGeneration = loader->getTextureGeneration();
+	_sheet = SpriteSheet::getAtlas();
+	if (!_sheet)
 	{
-		renderer->addImageTexture( "TANK", "assets/textures/tank.png");
+		_sheet = SpriteSheet::getResident(TANK_TEXTURE, std::string());
+		if (!_sheet)
+			_sheet.reset(new SpriteSheet(nullptr));
+		_sheet->addClip("TANK", { 0, 0, _sheet->getWidth(), _sheet->getHeight() });
 	}
+	_tankClip = _sheet->getHandle("TANK");
+}
+
+void Tank::View::setInterpolation(double const alpha)
+{
+	_alpha = alpha;
 }
 
 void Tank::View::display(void)
 {
 	Window * mainWindow = _platform->getWindowManager()->getWindowByName("mainWindow");
-	Renderer * renderer = mainWindow->getRenderer();
+	SDL_Renderer * renderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+
+	if (_sheetGeneration != AssetLoader::getInstance()->getTextureGeneration())
+		loadSheet();
 
-	renderer->setDrawColor(0, 0, 0, 255);
-	renderer->fill();
+	commands->setLayer(LAYER_BACKGROUND);
+	commands->fill(renderer, { 0, 0, 0, 255 });
 
-	renderer->printText("TANK", "courier", 12, { 255, 255, 255, 255 }, {10, 10, 100, 22});
+	commands->setLayer(LAYER_TEXT);
+	TextCache::getInstance()->printText(mainWindow,
+		"TANK", "courier", 12, { 255, 255, 255, 255 }, {10, 10, 100, 22});
 
-	renderer->copyEx("TANK", "", SDL_Rect{ (int)(_model->_x), (int)(_model->_y), 256, 256 },
-		_model->_dir, SDL_Point{ 128, 128 }, SDL_FLIP_NONE);
+	Store const & tanks(_model->getTanks());
+	std::pair<int, int> const size(mainWindow->getSize());
+	double x, y, dir;
+
+	_visible = 0;
+	_culled = 0;
+	_batch.begin(*_sheet);
+	_batch.reserve(tanks.size());
+
+	for (std::size_t tank(1); tank <= tanks.size(); ++tank)
+	{
+		/* The player's tank last, over the swarm */
+		std::size_t const index(tank % tanks.size());
+		double const radius(tanks.radius[index]);
 
-	renderer->setDrawColor(255, 0, 0, 255);
-	renderer->drawLine(
+		tanks.interpolate(index, _alpha, x, y, dir);
+		x += radius;
+		y += radius;
+
+		/* Whatever the rotation, the sprite stays within that reach */
+		double const reach(radius * M_SQRT2);
+		if (x + reach < 0. || x - reach > size.first
+			|| y + reach < 0. || y - reach > size.second)
+		{
+			++_culled;
+			continue;
+		}
+
+		_batch.addRotated(_tankClip,
+			static_cast<float>(x), static_cast<float>(y),
+			static_cast<float>(2. * radius), static_cast<float>(2. * radius),
+			dir);
+		++_visible;
+	}
+
+	commands->setLayer(LAYER_SPRITES);
+	_batch.submit(renderer);
+
+	commands->setLayer(LAYER_SHAPES);
+	commands->drawLine(renderer, { 255, 0, 0, 255 },
 		200,
 		200,
-		200 + 10*_model->_deltaX,
-		200 + 10*_model->_deltaY);
+		200 + 10*tanks.deltaX[0],
+		200 + 10*tanks.deltaY[0]);
 }
 
-void Tank::KeyboardEventHandler::handleEvent(
+std::size_t Tank::View::getVisible(void) const
+{
+	return _visible;
+}
+
+std::size_t Tank::View::getCulled(void) const
+{
+	return _culled;
+}
+
+void Tank::KeyboardEventHandler::handleInput(
 	SDL_Event const & e,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+	InputContext const & context)
 {
 	switch(e.type)
 	{
@@ -120,7 +260,7 @@ void Tank::KeyboardEventHandler::handleEvent(
 			switch(e.key.keysym.sym)
 			{
 				case SDLK_ESCAPE:
-					engineUpdate->popGameContext();
+					context.engineUpdate.popGameContext();
 				break;
 			}
 		break;
@@ -133,9 +273,9 @@ Tank::GameControllerEventHandler::GameControllerEventHandler(
 	_model(model)
 {}
 
-void Tank::GameControllerEventHandler::handleEvent(
+void Tank::GameControllerEventHandler::handleInput(
 	SDL_Event const & e,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+	InputContext const & context)
 {
 
 }
\ No newline at end of file
@@ -3,9 +3,36 @@
 
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/IEventHandler.hpp>
+#include "../Input/IInputHandler.hpp"
+#include "../Graphics/IInterpolable.hpp"
+#include "../Graphics/SpriteSheet.hpp"
+#include "../Graphics/SpriteBatch.hpp"
+#include "../System/AssetLoader.hpp"
+#include "TankStore.hpp"
 #include <memory>
 
+/* Simulation steps per second, and the step length the tuning was done at */
+#define TANK_SIMULATION_RATE 120
+#define TANK_REFERENCE_TICKS 16.
+
+/* The tank is driven by the first player */
+#define TANK_PLAYER 0
+
+/* Tanks move inside the main window's logical area */
+#define TANK_ARENA_WIDTH 1600.
+#define TANK_ARENA_HEIGHT 900.
+
+/* The player's tank, and the swarm's AI tanks, by hull radius (pixels) */
+#define TANK_PLAYER_RADIUS 128.
+#define TANK_SWARM_SIZE 2000
+#define TANK_SWARM_RADIUS 16.
+
+/* Broadphase cells hold a few swarm tanks ; the player's spans several */
+#define TANK_CELL_SIZE 64.
+
+/* Tanks per job of the per-tank passes : even, for the SSE2 kernel's pairs */
+#define TANK_JOB_GRAIN 1024
+
 
 namespace Tank
 {
@@ -14,47 +41,77 @@ namespace Tank
 		public:
 			static std::shared_ptr<GameContext> createGameControllerDebug(
 				std::shared_ptr<Platform> platform);
+			/* The player's tank among TANK_SWARM_SIZE AI-driven ones */
+			static std::shared_ptr<GameContext> createSwarm(
+				std::shared_ptr<Platform> platform);
+			static AssetLoader::Manifest getAssets(void);
 	};
 
 	class Model : public IModel
 	{
-		public:
+		private:
 			std::shared_ptr<Platform> _platform;
 
-			double _x;
-			double _y;
+			/* Tank 0 is the player's, every other one is AI-driven */
+			Store _tanks;
 
-			double _deltaX;
-			double _deltaY;
+			/* Collision detection buffers, kept between steps */
+			SpatialHash _hash;
+			std::vector<SpatialHash::Box> _boxes;
+			std::vector<SpatialHash::Pair> _pairs;
 
-			double _dir;
+			double _arenaWidth;
+			double _arenaHeight;
 
-			Model(std::shared_ptr<Platform> platform);
+		public:
+			Model(std::shared_ptr<Platform> platform,
+				std::size_t const aiTanks = 0,
+				double const arenaWidth = TANK_ARENA_WIDTH,
+				double const arenaHeight = TANK_ARENA_HEIGHT);
 
 			void elapse(Uint32 const gameTicks,
 				std::shared_ptr<EngineUpdate> engineUpdate);
+
+			Store const & getTanks(void) const;
 	};
 
-	class View : public IView
+	class View : public IView, public IInterpolable
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
 			std::shared_ptr<Model> _model;
+			double _alpha;
+
+			std::unique_ptr<SpriteSheet> _sheet;
+			unsigned int _sheetGeneration;
+			int _tankClip;
+
+			/* Every visible tank goes out as one textured triangle list */
+			SpriteBatch _batch;
+			std::size_t _visible;
+			std::size_t _culled;
+
+			void loadSheet(void);
 
 		public:
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<Model> model);
 			void display(void);
+			void setInterpolation(double const alpha);
+
+			/* Last display : tanks drawn, and tanks outside the window */
+			std::size_t getVisible(void) const;
+			std::size_t getCulled(void) const;
 	};
 
-	class KeyboardEventHandler : public IEventHandler
+	class KeyboardEventHandler : public IInputHandler
 	{
 		public:
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class GameControllerEventHandler : public IEventHandler
+	class GameControllerEventHandler : public IInputHandler
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
@@ -64,8 +121,8 @@ namespace Tank
 			GameControllerEventHandler(
 				std::shared_ptr<Platform> platform,
 				std::shared_ptr<Model> model);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 }
 
@@ -0,0 +1,345 @@
+#include "TankStore.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TANK_STORE_SSE2
+#endif
+
+namespace
+{
+	Uint32 nextRandom(Uint32 & seed)
+	{
+		/* xorshift32 : never reaches 0 from a non-zero seed */
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return seed;
+	}
+
+	double nextRandom(Uint32 & seed, double const low, double const high)
+	{
+		return low + (high - low) * (nextRandom(seed) / 4294967296.);
+	}
+
+#ifdef TANK_STORE_SSE2
+	/* Cephes' minimax coefficients for sin & cos over [-pi/4, pi/4] */
+	double const SIN_COEFFICIENTS[] = {
+		1.58962301576546568060e-10, -2.50507477628578072866e-8,
+		2.75573136213857245213e-6, -1.98412698295895385996e-4,
+		8.33333333332211858878e-3, -1.66666666666666307295e-1 };
+	double const COS_COEFFICIENTS[] = {
+		-1.13585365213876817300e-11, 2.08757008419747316778e-9,
+		-2.75573141792967388112e-7, 2.48015872888517045348e-5,
+		-1.38888888888730564116e-3, 4.16666666666665929218e-2 };
+
+	__m128d select(__m128d const mask, __m128d const ifSet, __m128d const ifClear)
+	{
+		return _mm_or_pd(_mm_and_pd(mask, ifSet), _mm_andnot_pd(mask, ifClear));
+	}
+
+	/*
+	 * Reduced in degrees, to the nearest multiple of 90 : exact, unlike a
+	 * reduction by pi/2 in radians. The quadrant then picks & signs the
+	 * polynomials.
+	 */
+	void sinCosDegrees(__m128d const degrees, __m128d & sine, __m128d & cosine)
+	{
+		__m128i const quadrant(_mm_cvtpd_epi32(
+			_mm_mul_pd(degrees, _mm_set1_pd(1. / 90.))));
+		__m128d const r(_mm_mul_pd(
+			_mm_sub_pd(degrees, _mm_mul_pd(_mm_cvtepi32_pd(quadrant), _mm_set1_pd(90.))),
+			_mm_set1_pd(M_PI / 180.)));
+		__m128d const r2(_mm_mul_pd(r, r));
+
+		__m128d s(_mm_set1_pd(SIN_COEFFICIENTS[0]));
+		__m128d c(_mm_set1_pd(COS_COEFFICIENTS[0]));
+		for (int term(1); term < 6; ++term)
+		{
+			s = _mm_add_pd(_mm_mul_pd(s, r2), _mm_set1_pd(SIN_COEFFICIENTS[term]));
+			c = _mm_add_pd(_mm_mul_pd(c, r2), _mm_set1_pd(COS_COEFFICIENTS[term]));
+		}
+		s = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, r2), s));
+		c = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(1.), _mm_mul_pd(_mm_set1_pd(.5), r2)),
+			_mm_mul_pd(_mm_mul_pd(r2, r2), c));
+
+		/* Both 32-bit halves of each 64-bit lane hold that lane's quadrant */
+		__m128i const q(_mm_shuffle_epi32(quadrant, _MM_SHUFFLE(1, 1, 0, 0)));
+		__m128i const one(_mm_set1_epi32(1));
+		__m128i const two(_mm_set1_epi32(2));
+		__m128d const swap(_mm_castsi128_pd(
+			_mm_cmpeq_epi32(_mm_and_si128(q, one), one)));
+
+		/* Bit 1 of the low half shifted into the sign bit */
+		__m128d const sineSign(_mm_castsi128_pd(
+			_mm_slli_epi64(_mm_and_si128(q, two), 62)));
+		__m128d const cosineSign(_mm_castsi128_pd(
+			_mm_slli_epi64(_mm_and_si128(_mm_add_epi32(q, one), two), 62)));
+
+		sine = _mm_xor_pd(select(swap, c, s), sineSign);
+		cosine = _mm_xor_pd(select(swap, s, c), cosineSign);
+	}
+#endif
+}
+
+std::size_t Tank::Store::add(double const x, double const y, double const dir,
+	double const radius)
+{
+	std::size_t const index(size());
+
+	this->x.push_back(x);
+	this->y.push_back(y);
+	this->dir.push_back(dir);
+	this->radius.push_back(radius);
+	deltaX.push_back(0.);
+	deltaY.push_back(0.);
+	previousX.push_back(x);
+	previousY.push_back(y);
+	previousDir.push_back(dir);
+	throttle.push_back(0.);
+	turn.push_back(0.);
+	seed.push_back((static_cast<Uint32>(index) + 1) * 2654435761u | 1);
+	course.push_back(0);
+
+	return index;
+}
+
+void Tank::Store::spawn(std::size_t const count,
+	double const width, double const height, double const radius)
+{
+	Uint32 random(static_cast<Uint32>(size() + 1) * 2246822519u | 1);
+
+	for (std::size_t tank(0); tank < count; ++tank)
+		add(nextRandom(random, 0., width - 2. * radius),
+			nextRandom(random, 0., height - 2. * radius),
+			nextRandom(random, 0., 360.),
+			radius);
+}
+
+void Tank::Store::clear(void)
+{
+	for (std::vector<double> * component : { &x, &y, &deltaX, &deltaY, &dir,
+		&radius, &previousX, &previousY, &previousDir, &throttle, &turn })
+		component->clear();
+	seed.clear();
+	course.clear();
+}
+
+std::size_t Tank::Store::size(void) const
+{
+	return x.size();
+}
+
+/*
+ * Course changes are rare : plain scalar code, each tank on its own timer.
+ * Tanks against a wall head back for the middle of the arena.
+ */
+void Tank::Store::steer(Uint32 const gameTicks,
+	std::size_t const first, std::size_t const last,
+	double const width, double const height)
+{
+	for (std::size_t index(first); index < last; ++index)
+	{
+		if (x[index] <= 0. || x[index] + 2. * radius[index] >= width
+			|| y[index] <= 0. || y[index] + 2. * radius[index] >= height)
+		{
+			dir[index] = std::atan2(height / 2. - y[index], width / 2. - x[index])
+				* (180. / M_PI);
+			previousDir[index] = dir[index];
+			turn[index] = 0.;
+			continue;
+		}
+
+		course[index] -= static_cast<Sint32>(gameTicks);
+		if (course[index] > 0)
+			continue;
+
+		course[index] = static_cast<Sint32>(nextRandom(seed[index],
+			TANK_AI_MIN_COURSE, TANK_AI_MAX_COURSE));
+		throttle[index] = nextRandom(seed[index], 20., 118.);
+		turn[index] = nextRandom(seed[index], -4., 4.);
+	}
+}
+
+void Tank::Store::step(std::size_t const index, double const scale)
+{
+	previousX[index] = x[index];
+	previousY[index] = y[index];
+	previousDir[index] = dir[index];
+
+	dir[index] = std::fmod(dir[index] + turn[index] * scale, 360.);
+
+	double const speed(throttle[index] / TANK_SPEED_DIVISOR);
+	double const radians(dir[index] * (M_PI / 180.));
+	deltaX[index] = speed * std::cos(radians);
+	deltaY[index] = speed * std::sin(radians);
+	x[index] += deltaX[index] * scale;
+	y[index] += deltaY[index] * scale;
+}
+
+void Tank::Store::integrateScalar(double const scale)
+{
+	for (std::size_t index(0); index < size(); ++index)
+		step(index, scale);
+}
+
+void Tank::Store::integrate(double const scale)
+{
+	integrate(scale, 0, size());
+}
+
+void Tank::Store::integrate(double const scale,
+	std::size_t const first, std::size_t const last)
+{
+	std::size_t index(first);
+
+#ifdef TANK_STORE_SSE2
+	__m128d const steps(_mm_set1_pd(scale));
+	__m128d const divisor(_mm_set1_pd(1. / TANK_SPEED_DIVISOR));
+
+	for (; index + 2 <= last; index += 2)
+	{
+		__m128d const oldX(_mm_loadu_pd(&x[index]));
+		__m128d const oldY(_mm_loadu_pd(&y[index]));
+		__m128d const oldDir(_mm_loadu_pd(&dir[index]));
+
+		_mm_storeu_pd(&previousX[index], oldX);
+		_mm_storeu_pd(&previousY[index], oldY);
+		_mm_storeu_pd(&previousDir[index], oldDir);
+
+		/*
+		 * fmod(angle, 360) : truncated quotient, as fmod. Exact multiples of
+		 * 360 may land a rounding away from 0 or 360, which draws the same.
+		 */
+		__m128d const angle(_mm_add_pd(oldDir,
+			_mm_mul_pd(_mm_loadu_pd(&turn[index]), steps)));
+		__m128d const turns(_mm_cvtepi32_pd(_mm_cvttpd_epi32(
+			_mm_mul_pd(angle, _mm_set1_pd(1. / 360.)))));
+		__m128d const newDir(_mm_sub_pd(angle, _mm_mul_pd(turns, _mm_set1_pd(360.))));
+
+		__m128d sine, cosine;
+		sinCosDegrees(newDir, sine, cosine);
+
+		__m128d const speed(_mm_mul_pd(_mm_loadu_pd(&throttle[index]), divisor));
+		__m128d const newDeltaX(_mm_mul_pd(speed, cosine));
+		__m128d const newDeltaY(_mm_mul_pd(speed, sine));
+
+		_mm_storeu_pd(&dir[index], newDir);
+		_mm_storeu_pd(&deltaX[index], newDeltaX);
+		_mm_storeu_pd(&deltaY[index], newDeltaY);
+		_mm_storeu_pd(&x[index], _mm_add_pd(oldX, _mm_mul_pd(newDeltaX, steps)));
+		_mm_storeu_pd(&y[index], _mm_add_pd(oldY, _mm_mul_pd(newDeltaY, steps)));
+	}
+#endif
+
+	for (; index < last; ++index)
+		step(index, scale);
+}
+
+void Tank::Store::sweep(std::vector<SpatialHash::Box> & boxes) const
+{
+	boxes.resize(size());
+	sweep(boxes, 0, size());
+}
+
+void Tank::Store::sweep(std::vector<SpatialHash::Box> & boxes,
+	std::size_t const first, std::size_t const last) const
+{
+	for (std::size_t index(first); index < last; ++index)
+	{
+		double const diameter(2. * radius[index]);
+
+		boxes[index] = {
+			std::min(previousX[index], x[index]),
+			std::min(previousY[index], y[index]),
+			std::max(previousX[index], x[index]) + diameter,
+			std::max(previousY[index], y[index]) + diameter };
+	}
+}
+
+/*
+ * Exact for straight moves : the first time in [0, 1] at which the centers,
+ * each moving from its previous to its current position, are the sum of the
+ * radii apart. Hulls that already overlapped are pushed apart instead.
+ */
+void Tank::Store::resolve(std::vector<SpatialHash::Pair> const & pairs,
+	std::size_t const first)
+{
+	for (SpatialHash::Pair const & pair : pairs)
+	{
+		std::size_t const a(pair.first), b(pair.second);
+		double const reach(radius[a] + radius[b]);
+
+		/* B relative to A : at the previous step, and its motion since */
+		double const startX((previousX[b] + radius[b]) - (previousX[a] + radius[a]));
+		double const startY((previousY[b] + radius[b]) - (previousY[a] + radius[a]));
+		double const moveX((x[b] + radius[b]) - (x[a] + radius[a]) - startX);
+		double const moveY((y[b] + radius[b]) - (y[a] + radius[a]) - startY);
+
+		double const c(startX * startX + startY * startY - reach * reach);
+		if (c <= 0.)
+		{
+			double const gapX((x[b] + radius[b]) - (x[a] + radius[a]));
+			double const gapY((y[b] + radius[b]) - (y[a] + radius[a]));
+			double const distance(std::sqrt(gapX * gapX + gapY * gapY));
+			if (distance >= reach)
+				continue;
+
+			double const push((reach - distance) / 2.);
+			double const unitX(distance > 0. ? gapX / distance : 1.);
+			double const unitY(distance > 0. ? gapY / distance : 0.);
+			x[a] -= unitX * push;
+			y[a] -= unitY * push;
+			x[b] += unitX * push;
+			y[b] += unitY * push;
+			continue;
+		}
+
+		double const squared(moveX * moveX + moveY * moveY);
+		double const half(startX * moveX + startY * moveY);
+		double const discriminant(half * half - squared * c);
+		if (squared <= 0. || half >= 0. || discriminant < 0.)
+			continue;
+
+		double const time((-half - std::sqrt(discriminant)) / squared);
+		if (time > 1.)
+			continue;
+
+		for (std::size_t const index : { a, b })
+		{
+			x[index] = previousX[index] + (x[index] - previousX[index]) * time;
+			y[index] = previousY[index] + (y[index] - previousY[index]) * time;
+
+			if (index < first)
+				continue;
+			dir[index] = std::fmod(dir[index] + 180., 360.);
+			previousDir[index] = std::fmod(previousDir[index] + 180., 360.);
+		}
+	}
+}
+
+void Tank::Store::confine(double const width, double const height)
+{
+	for (std::size_t index(0); index < size(); ++index)
+	{
+		double const diameter(2. * radius[index]);
+
+		x[index] = std::max(0., std::min(x[index], width - diameter));
+		y[index] = std::max(0., std::min(y[index], height - diameter));
+	}
+}
+
+void Tank::Store::interpolate(std::size_t const index, double const alpha,
+	double & x, double & y, double & dir) const
+{
+	double turn(std::fmod(this->dir[index] - previousDir[index], 360.));
+	if (turn > 180.)
+		turn -= 360.;
+	else if (turn < -180.)
+		turn += 360.;
+
+	x = previousX[index] + (this->x[index] - previousX[index]) * alpha;
+	y = previousY[index] + (this->y[index] - previousY[index]) * alpha;
+	dir = previousDir[index] + turn * alpha;
+}
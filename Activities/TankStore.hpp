@@ -0,0 +1,100 @@
+#ifndef TANK_STORE_HPP_INCLUDED
+#define TANK_STORE_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include "../System/SpatialHash.hpp"
+#include <cstddef>
+#include <vector>
+
+/* Throttle units per pixel of travel per reference step */
+#define TANK_SPEED_DIVISOR 20.
+
+/* AI tanks keep a course for that long (game ticks) before picking another */
+#define TANK_AI_MIN_COURSE 500
+#define TANK_AI_MAX_COURSE 3000
+
+namespace Tank
+{
+	/*
+	 * Every tank's components, one contiguous array per component, tank i
+	 * being element i of each. Whatever drives a tank (input, AI) writes its
+	 * throttle & turn ; integrate() then moves all of them at once, two
+	 * tanks per SSE2 instruction where available.
+	 *
+	 * A tank's position is the top left corner of its square, its hull the
+	 * circle inscribed in that square.
+	 */
+	class Store
+	{
+		public:
+			/* Position & velocity in pixels, heading in degrees */
+			std::vector<double> x;
+			std::vector<double> y;
+			std::vector<double> deltaX;
+			std::vector<double> deltaY;
+			std::vector<double> dir;
+			std::vector<double> radius;
+
+			/* State at the previous step, for render interpolation */
+			std::vector<double> previousX;
+			std::vector<double> previousY;
+			std::vector<double> previousDir;
+
+			/* Controls : throttle units & degrees per reference step */
+			std::vector<double> throttle;
+			std::vector<double> turn;
+
+			/* AI state : random generator & ticks left on the current course */
+			std::vector<Uint32> seed;
+			std::vector<Sint32> course;
+
+			std::size_t add(double const x, double const y, double const dir,
+				double const radius);
+
+			/* Adds <count> AI tanks at random spots of the arena */
+			void spawn(std::size_t const count,
+				double const width, double const height, double const radius);
+			void clear(void);
+			std::size_t size(void) const;
+
+			/*
+			 * Per-tank passes also come for tanks [first, last) only : ranges
+			 * that do not overlap can run on different threads.
+			 */
+
+			/* New courses, back to the arena if out */
+			void steer(Uint32 const gameTicks,
+				std::size_t const first, std::size_t const last,
+				double const width, double const height);
+
+			/* One simulation step of <scale> reference steps */
+			void integrate(double const scale);
+			void integrate(double const scale,
+				std::size_t const first, std::size_t const last);
+			void integrateScalar(double const scale);
+
+			/* Each hull's bounds over the last step, from previous to current */
+			void sweep(std::vector<SpatialHash::Box> & boxes) const;
+			void sweep(std::vector<SpatialHash::Box> & boxes,
+				std::size_t const first, std::size_t const last) const;
+
+			/*
+			 * Hulls that met during the last step stop where they first
+			 * touched, tanks [first, size()) then turning back.
+			 */
+			void resolve(std::vector<SpatialHash::Pair> const & pairs,
+				std::size_t const first);
+
+			/* Keeps every hull within the arena */
+			void confine(double const width, double const height);
+
+			/* Blend of the last two steps, turning the short way round */
+			void interpolate(std::size_t const index, double const alpha,
+				double & x, double & y, double & dir) const;
+
+		private:
+			void step(std::size_t const index, double const scale);
+	};
+}
+
+#endif // TANK_STORE_HPP_INCLUDED
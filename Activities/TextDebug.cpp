@@ -6,6 +6,10 @@
 #include <VBN/EngineUpdate.hpp>
 #include <VBN/GameControllerManager.hpp>
 #include <VBN/Logging.hpp>
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Input/InputService.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
 
 /* ----------------------------------------------- */
 /* ------------------- FACTORY ------------------- */
@@ -20,7 +24,7 @@ std::shared_ptr<GameContext> TextDebug::Factory::createTextDebug(
 		model,
 		std::make_shared<TextDebug::View>(platform, model),
 		nullptr,
-		std::make_shared<TextDebug::KeyboardEventHandler>(),
+		std::make_shared<TextDebug::KeyboardEventHandler>(model),
 		std::make_shared<TextDebug::GameControllerEventHandler>(model),
 		nullptr,
 		nullptr);
@@ -35,30 +39,29 @@ TextDebug::Model::Model(std::shared_ptr<Platform> platform) :
 	_fontSize(18),
 	_drawSpace({45, 45, 600, 600}),
 	aGT(0), bGT(0), xGT(0), yGT(0),
-	upGT(0), downGT(0), leftGT(0), rightGT(0)
+	upGT(0), downGT(0), leftGT(0), rightGT(0),
+	_useGlyphAtlas(true),
+	_repeating(false)
 {}
 
 void TextDebug::Model::elapse(Uint32 const gameTicks,
 	std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	GameControllerManager * gameControllerManager(nullptr);
-	GameController * gameController(nullptr);
-	SDL_GameController * sdlController(nullptr);
+	InputSnapshot const & input(InputService::getInstance()->getSnapshot());
 
 	bool a(false), b(false), x(false), y(false),
 		down(false), up(false), left(false), right(false);
 
 	Uint32 delay(10), delta(5);
 
-	gameControllerManager = _platform->getGameControllerManager();
-	if (gameControllerManager)
-		gameController = gameControllerManager->getControllerFromDeviceID(0);
-	if (gameController)
-		sdlController = gameController->getSDLGameController();
-	if (sdlController)
+	_repeating = false;
+
+	if (input.isConnected(TEXT_DEBUG_PLAYER))
 	{
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_A))
+		/* Held buttons keep moving the text without any new event */
+		_repeating = (input.buttons[TEXT_DEBUG_PLAYER] != 0);
+
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_A))
 		{
 			aGT += gameTicks;
 			if (aGT > delay)
@@ -70,8 +73,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			aGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_B))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_B))
 		{
 			bGT += gameTicks;
 			if (bGT > delay)
@@ -83,8 +85,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			bGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_X))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_X))
 		{
 			xGT += gameTicks;
 			if (xGT > delay)
@@ -96,8 +97,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			xGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_Y))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_Y))
 		{
 			yGT += gameTicks;
 			if (yGT > delay)
@@ -109,8 +109,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			yGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_DPAD_UP))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_DPAD_UP))
 		{
 			upGT += gameTicks;
 			if (upGT > delay)
@@ -122,8 +121,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			upGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_DPAD_DOWN))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_DPAD_DOWN))
 		{
 			downGT += gameTicks;
 			if (downGT > delay)
@@ -135,8 +133,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			downGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_DPAD_LEFT))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_DPAD_LEFT))
 		{
 			leftGT += gameTicks;
 			if (leftGT > delay)
@@ -148,8 +145,7 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 		else
 			leftGT = 0;
 
-		if (SDL_GameControllerGetButton(sdlController,
-			SDL_CONTROLLER_BUTTON_DPAD_RIGHT))
+		if (input.getButton(TEXT_DEBUG_PLAYER, SDL_CONTROLLER_BUTTON_DPAD_RIGHT))
 		{
 			rightGT += gameTicks;
 			if (rightGT > delay)
@@ -163,6 +159,11 @@ void TextDebug::Model::elapse(Uint32 const gameTicks,
 	}
 }
 
+Uint32 TextDebug::Model::getIdleTime(void) const
+{
+	return _repeating ? 0 : IDLE_FOREVER;
+}
+
 unsigned int TextDebug::Model::getFontSize(void)
 {
 	return _fontSize;
@@ -223,6 +224,16 @@ void TextDebug::Model::downFont(int amount)
 	_fontSize -= amount;
 }
 
+bool TextDebug::Model::getUseGlyphAtlas(void)
+{
+	return _useGlyphAtlas;
+}
+
+void TextDebug::Model::toggleGlyphAtlas(void)
+{
+	_useGlyphAtlas = !_useGlyphAtlas;
+}
+
 /* ---------------------------------------------- */
 /* -------------------- VIEW -------------------- */
 /* ---------------------------------------------- */
@@ -247,28 +258,47 @@ TextDebug::View::View(std::shared_ptr<Platform> platform,
 		SDL_Color{ 255, 255, 255, 255 });
 }
 
+Uint32 TextDebug::View::getIdleTime(void) const
+{
+	return IDLE_FOREVER;
+}
+
 void TextDebug::View::display(void)
 {
 	// Acquire Window & Renderer for later use
 	Window * mainWindow = _platform->getWindowManager()->getWindowByName("mainWindow");
 	Renderer * renderer = mainWindow->getRenderer();
 	Texture * utf8text = renderer->getTexture("UTF");
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
 
 	// Clear screen
-	renderer->setDrawColor(0, 0, 32, 255);
-	renderer->fill();
+	commands->setLayer(LAYER_BACKGROUND);
+	commands->fill(getSDLRenderer(mainWindow), { 0, 0, 32, 255 });
 
 	// Print debug text in dynamically-adjusted Drawing Space
-	renderer->printText("Lorem ipsum dolor sit amet, consectetur adipiscing "
+	std::string const loremIpsum("Lorem ipsum dolor sit amet, consectetur adipiscing "
 		"elit, sed do eiusmod tempor incididunt ut labore et dolore magna "
 		"aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco "
 		"laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure "
 		"dolor in reprehenderit in voluptate velit esse cillum dolore eu "
 		"fugiat nulla pariatur.\n"
 		"Excepteur sint occaecat cupidatat non proident, "
-		"sunt in culpa qui officia deserunt mollit anim id est laborum.\n",
-		"courier", _model->getFontSize(), { 255, 255, 255, 255 },
-		_model->getDrawSpace());
+		"sunt in culpa qui officia deserunt mollit anim id est laborum.\n");
+
+	// 'T' switches between glyph atlas & TTF rasterization ("text" benchmark)
+	if (_model->getUseGlyphAtlas())
+		TextCache::getInstance()->printText(mainWindow, loremIpsum,
+			"courier", _model->getFontSize(), { 255, 255, 255, 255 },
+			_model->getDrawSpace());
+	else
+	{
+		/* Drawn immediately : what was recorded so far goes first */
+		commands->flush();
+		renderer->printText(loremIpsum,
+			"courier", _model->getFontSize(), { 255, 255, 255, 255 },
+			_model->getDrawSpace());
+		commands->begin(getSDLRenderer(mainWindow));
+	}
 
 	mainWindow->getRenderer()->copy(
 		"UTF", "",
@@ -280,8 +310,12 @@ void TextDebug::View::display(void)
 /* -------------------- CONTROLLER -------------------- */
 /* ---------------------------------------------------- */
 
-void TextDebug::KeyboardEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+TextDebug::KeyboardEventHandler::KeyboardEventHandler(
+	std::shared_ptr<Model> model) : _model(model)
+{}
+
+void TextDebug::KeyboardEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch(event.type)
 	{
@@ -289,7 +323,10 @@ void TextDebug::KeyboardEventHandler::handleEvent(SDL_Event const & event,
 			switch(event.key.keysym.sym)
 			{
 				case SDLK_ESCAPE:
-					engineUpdate->popGameContext();
+					context.engineUpdate.popGameContext();
+				break;
+				case SDLK_t:
+					_model->toggleGlyphAtlas();
 				break;
 			}
 		break;
@@ -300,8 +337,8 @@ TextDebug::GameControllerEventHandler::GameControllerEventHandler(
 	std::shared_ptr<Model> model) : _model(model)
 {}
 
-void TextDebug::GameControllerEventHandler::handleEvent(SDL_Event const & event,
-	std::shared_ptr<EngineUpdate> engineUpdate)
+void TextDebug::GameControllerEventHandler::handleInput(SDL_Event const & event,
+	InputContext const & context)
 {
 	switch (event.type)
 	{
@@ -3,7 +3,11 @@
 
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
-#include <VBN/IEventHandler.hpp>
+#include "../Input/IInputHandler.hpp"
+#include "../System/IIdle.hpp"
+
+/* Both texts are moved with the first player's controller */
+#define TEXT_DEBUG_PLAYER 0
 
 namespace TextDebug
 {
@@ -14,7 +18,7 @@ namespace TextDebug
 				std::shared_ptr<Platform> platform);
 	};
 
-	class Model : public IModel
+	class Model : public IModel, public IIdle
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
@@ -31,10 +35,14 @@ namespace TextDebug
 			Uint32 leftGT;
 			Uint32 rightGT;
 
+			bool _useGlyphAtlas;
+			bool _repeating;
+
 		public:
 			Model(std::shared_ptr<Platform> platform);
 			void elapse(Uint32 const gameTicks,
 				std::shared_ptr<EngineUpdate> engineUpdate);
+			Uint32 getIdleTime(void) const;
 
 			unsigned int getFontSize(void);
 			SDL_Rect const & getDrawSpace(void);
@@ -50,27 +58,34 @@ namespace TextDebug
 
 			void upFont(int amount);
 			void downFont(int amount);
+
+			bool getUseGlyphAtlas(void);
+			void toggleGlyphAtlas(void);
 	};
 
-	class KeyboardEventHandler : public IEventHandler
+	class KeyboardEventHandler : public IInputHandler
 	{
+		private:
+			std::shared_ptr<Model> _model;
+
 		public:
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			KeyboardEventHandler(std::shared_ptr<Model> model);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class GameControllerEventHandler : public IEventHandler
+	class GameControllerEventHandler : public IInputHandler
 	{
 		private:
 			std::shared_ptr<Model> _model;
 
 		public:
 			GameControllerEventHandler(std::shared_ptr<Model> model);
-			void handleEvent(SDL_Event const & event,
-				std::shared_ptr<EngineUpdate> engineUpdate);
+			void handleInput(SDL_Event const & event,
+				InputContext const & context);
 	};
 
-	class View : public IView
+	class View : public IView, public IIdle
 	{
 		private:
 			std::shared_ptr<Platform> _platform;
@@ -80,6 +95,7 @@ namespace TextDebug
 			View(std::shared_ptr<Platform> platform,
 				std::shared_ptr<Model> model);
 			void display(void);
+			Uint32 getIdleTime(void) const;
 	};
 };
 
@@ -1,4 +1,13 @@
 #include "GameContext.hpp"
+#include "Graphics/IInterpolable.hpp"
+#include "System/IIdle.hpp"
+#include "System/FrameProfiler.hpp"
+#include "System/StartupTrace.hpp"
+#include "System/JobSystem.hpp"
+#include "Input/InputRecorder.hpp"
+#include "Input/IInputHandler.hpp"
+#include "Input/EventCoalescer.hpp"
+#include "Input/InputService.hpp"
 #include <VBN/Platform.hpp>
 #include <VBN/IModel.hpp>
 #include <VBN/IView.hpp>
@@ -7,32 +16,351 @@
 #include <VBN/Logging.hpp>
 #include <VBN/WindowManager.hpp>
 #include <VBN/GameControllerManager.hpp>
+#include <algorithm>
+
+Uint64 GameContext::_frame(0);
+Uint64 GameContext::_nextGeneration(1);
+Uint64 GameContext::_lastDisplayed(0);
 
 GameContext::GameContext(
+	std::shared_ptr<Platform> platform,
 	std::shared_ptr<IModel> model,
 	std::shared_ptr<IView> view,
 	std::shared_ptr<IEventHandler> eventHandler) :
+	_platform(platform),
 	_model(model),
 	_view(view),
-	_eventHandler(eventHandler)
-{}
+	_eventHandler(eventHandler),
+	_inputHandler(std::dynamic_pointer_cast<IInputHandler>(eventHandler)),
+	_interpolable(std::dynamic_pointer_cast<IInterpolable>(view)),
+	_idleModel(std::dynamic_pointer_cast<IIdle>(model)),
+	_idleView(std::dynamic_pointer_cast<IIdle>(view)),
+	_tickRatio(1.),
+	_tickRemainder(0.),
+	_maxUpdateRate(UNCAPPED_UPDATE_RATE),
+	_pendingTicks(0),
+	_fixedRate(0),
+	_accumulator(0),
+	_stepCount(0),
+	_coalescing(false),
+	_batchFrame(0),
+	_idleEnabled(true),
+	_dirty(true),
+	_displayedFrames(0),
+	_generation(_nextGeneration++)
+{
+	_batchedEvents.reserve(EVENT_BATCH_RESERVE);
+}
+
+void GameContext::setTickRatio(double const ratio)
+{
+	_tickRatio = ratio;
+	_tickRemainder = 0.;
+}
+
+double GameContext::getTickRatio(void) const
+{
+	return _tickRatio;
+}
+
+void GameContext::setMaxUpdateRate(Uint32 const updatesPerSecond)
+{
+	_maxUpdateRate = updatesPerSecond;
+	_pendingTicks = 0;
+}
+
+Uint32 GameContext::getMaxUpdateRate(void) const
+{
+	return _maxUpdateRate;
+}
+
+void GameContext::setFixedRate(Uint32 const stepsPerSecond)
+{
+	_fixedRate = stepsPerSecond;
+	_accumulator = 0;
+	_stepCount = 0;
+}
+
+Uint32 GameContext::getFixedRate(void) const
+{
+	return _fixedRate;
+}
+
+double GameContext::getInterpolation(void) const
+{
+	if (!_fixedRate)
+		return 1.;
+
+	return static_cast<double>(_accumulator) / 1000.;
+}
+
+void GameContext::setIdleEnabled(bool const state)
+{
+	_idleEnabled = state;
+	_dirty = true;
+}
+
+bool GameContext::isIdleEnabled(void) const
+{
+	return _idleEnabled;
+}
+
+/*
+ * Time before anything changes on screen without input, 0 if a redraw is
+ * due every frame. Engine ticks are taken as milliseconds, which holds at
+ * the global 1:1 ratio main runs the engine with.
+ */
+Uint32 GameContext::getIdleTime(void) const
+{
+	Uint32 modelIdle(IDLE_FOREVER);
+
+	if (!_idleEnabled || !_idleView)
+		return 0;
+
+	if (_model && _maxUpdateRate)
+	{
+		modelIdle = _idleModel ? _idleModel->getIdleTime() : 0;
+
+		/* Whatever its own deadline, a model only changes when updated */
+		if (modelIdle != IDLE_FOREVER && _maxUpdateRate != UNCAPPED_UPDATE_RATE)
+		{
+			Uint64 const period((1000 + _maxUpdateRate - 1) / _maxUpdateRate);
+			if (_pendingTicks < period)
+				modelIdle = std::max(modelIdle,
+					static_cast<Uint32>(period - _pendingTicks));
+		}
+	}
+
+	return std::min(modelIdle, _idleView->getIdleTime());
+}
+
+Uint64 GameContext::getDisplayedFrames(void) const
+{
+	return _displayedFrames;
+}
 
 void GameContext::handleEvent(SDL_Event const & event,
 				std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	if (_eventHandler)
-		_eventHandler->handleEvent(event, engineUpdate);
+	FrameProfiler::Probe probe(FrameProfiler::EVENTS);
+
+	/* Records user input, or drops it while a recording is replayed */
+	if (!InputRecorder::getInstance()->acceptLiveEvent(event))
+		return;
+
+	_dirty = true;
+	queueEvent(event, engineUpdate);
+}
+
+/* Motion only : discrete events keep being handled as soon as they arrive */
+bool GameContext::isBatched(SDL_Event const & event)
+{
+	switch (event.type)
+	{
+		case SDL_MOUSEMOTION:
+		case SDL_CONTROLLERAXISMOTION:
+		case SDL_JOYAXISMOTION:
+		case SDL_JOYBALLMOTION:
+		case SDL_JOYHATMOTION:
+			return true;
+		case SDL_WINDOWEVENT:
+			return event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED;
+		default:
+			return false;
+	}
+}
+
+void GameContext::setCoalescing(bool const state)
+{
+	_coalescing = state;
+}
+
+bool GameContext::isCoalescing(void) const
+{
+	return _coalescing;
+}
+
+/* Anything not batched flushes the batch first, so order is preserved */
+void GameContext::queueEvent(SDL_Event const & event,
+	std::shared_ptr<EngineUpdate> const & engineUpdate)
+{
+	/* Plain VBN handlers take every event on its own */
+	if (!_inputHandler)
+	{
+		if (_eventHandler)
+			_eventHandler->handleEvent(event, engineUpdate);
+		return;
+	}
+
+	if (isBatched(event))
+	{
+		if (_batchedEvents.empty())
+			_batchFrame = _frame;
+		_batchedEvents.push_back(event);
+		return;
+	}
+
+	flushEvents(*engineUpdate);
+	dispatch(&event, 1, *engineUpdate);
+}
+
+void GameContext::flushEvents(EngineUpdate & engineUpdate)
+{
+	if (_batchedEvents.empty())
+		return;
+
+	/* Queued before a context push, this context not having run since */
+	if (_batchFrame != _frame)
+	{
+		_batchedEvents.clear();
+		return;
+	}
+
+	FrameProfiler::Probe probe(FrameProfiler::EVENTS);
+
+	/* Discrete events split batches : nothing is merged across them */
+	if (_coalescing)
+		_batchedEvents.resize(EventCoalescer::coalesce(_batchedEvents.data(),
+			_batchedEvents.size()));
+
+	dispatch(_batchedEvents.data(), _batchedEvents.size(), engineUpdate);
+	_batchedEvents.clear();
+}
+
+/* The only window lookup of the whole handler chain */
+void GameContext::dispatch(SDL_Event const * events, std::size_t const count,
+	EngineUpdate & engineUpdate)
+{
+	InputContext const context{ engineUpdate, *_platform,
+		_platform->getWindowManager()->getWindowByName("mainWindow"), this };
+
+	if (count == 1)
+		_inputHandler->handleInput(*events, context);
+	else
+		_inputHandler->handleInputBatch(events, count, context);
 }
 
 void GameContext::display(void)
 {
-	if (_view)
-		_view->display();
+	++_frame;
+
+	/* Back on top of the stack : whatever was displayed meanwhile is stale */
+	if (_lastDisplayed != _generation)
+		_dirty = true;
+	_lastDisplayed = _generation;
+
+	/* Nothing to redraw : sleep until an event or the next deadline */
+	if (!_dirty)
+	{
+		Uint32 const idleTime(getIdleTime());
+		if (idleTime)
+		{
+			SDL_WaitEventTimeout(nullptr,
+				static_cast<int>(std::min(idleTime, MAX_IDLE_WAIT)));
+			return;
+		}
+	}
+	_dirty = false;
+	++_displayedFrames;
+
+	{
+		FrameProfiler::Probe probe(FrameProfiler::DISPLAY);
+
+		if (_interpolable)
+			_interpolable->setInterpolation(getInterpolation());
+
+		if (_view)
+			_view->display();
+	}
+
+	/* Display closes the frame : events & elapse came before it */
+	if (FrameProfiler::isEnabled())
+		FrameProfiler::getInstance()->endFrame();
+	if (!StartupTrace::isFirstFrameDone())
+		StartupTrace::getInstance()->markFirstFrame();
 }
 
 void GameContext::elapse(Uint32 const gameTicks,
 	std::shared_ptr<EngineUpdate> engineUpdate)
 {
-	if(_model)
+	/* This frame's motion reaches the handlers before the model runs */
+	flushEvents(*engineUpdate);
+
+	FrameProfiler::Probe probe(FrameProfiler::ELAPSE);
+
+	/* Replayed ticks carry their recorded length & the input preceding them */
+	Uint32 const ticks(InputRecorder::getInstance()->beginTick(gameTicks,
+		_replayedEvents));
+
+	/* At most one controller sample per frame, on the model's first read */
+	InputService::getInstance()->update();
+
+	if (!_replayedEvents.empty())
+		_dirty = true;
+	for (SDL_Event const & event : _replayedEvents)
+		queueEvent(event, engineUpdate);
+	flushEvents(*engineUpdate);
+
+	/* A 0 Hz context is frozen : its time is not even banked */
+	if (!_model || !_maxUpdateRate)
+		return;
+
+	/* Not due yet : keep the engine ticks for the next update */
+	_pendingTicks += ticks;
+	if (_maxUpdateRate != UNCAPPED_UPDATE_RATE
+		&& _pendingTicks * _maxUpdateRate < 1000)
+		return;
+
+	_tickRemainder += _pendingTicks * _tickRatio;
+	_pendingTicks = 0;
+
+	Uint32 const localTicks(static_cast<Uint32>(_tickRemainder));
+	_tickRemainder -= localTicks;
+
+	if (!localTicks)
+		return;
+
+	/* Models idle until input do not change by elapsing */
+	if (!_idleModel || _idleModel->getIdleTime() != IDLE_FOREVER)
+		_dirty = true;
+	advance(localTicks, engineUpdate);
+}
+
+void GameContext::advance(Uint32 const gameTicks,
+	std::shared_ptr<EngineUpdate> engineUpdate)
+{
+	if (!_fixedRate)
+	{
 		_model->elapse(gameTicks, engineUpdate);
+		JobSystem::getInstance()->joinFrame();
+		return;
+	}
+
+	/*
+	 * The accumulator counts game ticks scaled by the step rate, so one step
+	 * is exactly 1000 units and no rounding error builds up. Steps are handed
+	 * whole ticks, alternating lengths so their sum matches elapsed time.
+	 */
+	unsigned int steps(0);
+
+	_accumulator += static_cast<Uint64>(gameTicks) * _fixedRate;
+	while (_accumulator >= 1000)
+	{
+		if (steps == MAX_FIXED_STEPS_PER_ELAPSE)
+		{
+			_accumulator %= 1000;
+			break;
+		}
+
+		Uint32 const stepTicks(static_cast<Uint32>(
+			((_stepCount + 1) * 1000) / _fixedRate
+			- (_stepCount * 1000) / _fixedRate));
+
+		/* Each step starts from the previous one's completed state */
+		_model->elapse(stepTicks, engineUpdate);
+		JobSystem::getInstance()->joinFrame();
+		_accumulator -= 1000;
+		++_stepCount;
+		++steps;
+	}
 }
@@ -2,13 +2,32 @@
 #define GAME_CONTEXT_HPP_INCLUDED
 
 #include <VBN/IGameContext.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/* Upper bound of simulation steps per elapse, past which time is dropped */
+#define MAX_FIXED_STEPS_PER_ELAPSE 8
+
+/* Maximum update rate meaning "every time the engine elapses" */
+#define UNCAPPED_UPDATE_RATE 0xFFFFFFFFu
+
+/* Longest single wait on the event queue while idle, in milliseconds */
+#define MAX_IDLE_WAIT 1000u
+
+/* Initial capacity of the queue of events dispatched once per frame */
+#define EVENT_BATCH_RESERVE 256
 
 class Platform;
 class IEventHandler;
 class IView;
 class IModel;
+class IInterpolable;
+class IIdle;
+class IInputHandler;
 
-class GameContext : public IGameContext
+class GameContext : public IGameContext,
+	public std::enable_shared_from_this<GameContext>
 {
 	private:
 		std::shared_ptr<Platform> _platform;
@@ -16,13 +35,74 @@ class GameContext : public IGameContext
 		std::shared_ptr<IModel> _model;
 		std::shared_ptr<IView> _view;
 		std::shared_ptr<IEventHandler> _eventHandler;
+		std::shared_ptr<IInputHandler> _inputHandler;
+		std::shared_ptr<IInterpolable> _interpolable;
+		std::shared_ptr<IIdle> _idleModel;
+		std::shared_ptr<IIdle> _idleView;
+
+		/* Local game ticks per engine tick, fractional part carried over */
+		double _tickRatio;
+		double _tickRemainder;
+
+		/* Update scheduling : engine ticks are banked until an update is due */
+		Uint32 _maxUpdateRate;
+		Uint64 _pendingTicks;
+
+		/* Fixed timestep : steps per 1000 game ticks, 0 for variable step */
+		Uint32 _fixedRate;
+		Uint64 _accumulator;
+		Uint64 _stepCount;
+
+		/* Input replay : recorded events due before the current tick */
+		std::vector<SDL_Event> _replayedEvents;
+
+		/* High-frequency events, dispatched as one batch per frame */
+		std::vector<SDL_Event> _batchedEvents;
+		bool _coalescing;
+
+		/* Frames displayed by any context : tells batches left behind */
+		static Uint64 _frame;
+		Uint64 _batchFrame;
+
+		/* Idle mode : redraw only after input or a model change */
+		bool _idleEnabled;
+		bool _dirty;
+		Uint64 _displayedFrames;
+
+		/* Never reused, unlike addresses : tells which context displayed last */
+		Uint64 const _generation;
+		static Uint64 _nextGeneration;
+		static Uint64 _lastDisplayed;
+
+		void advance(Uint32 const gameTicks,
+			std::shared_ptr<EngineUpdate> engineUpdate);
+
+		void queueEvent(SDL_Event const & event,
+			std::shared_ptr<EngineUpdate> const & engineUpdate);
+		void dispatch(SDL_Event const * events, std::size_t const count,
+			EngineUpdate & engineUpdate);
 
 	public:
 		GameContext(
+			std::shared_ptr<Platform> platform,
 			std::shared_ptr<IModel> model,
 			std::shared_ptr<IView> view,
 			std::shared_ptr<IEventHandler> eventHandler);
 
+		void setTickRatio(double const ratio);
+		double getTickRatio(void) const;
+		void setMaxUpdateRate(Uint32 const updatesPerSecond);
+		Uint32 getMaxUpdateRate(void) const;
+
+		void setFixedRate(Uint32 const stepsPerSecond);
+		Uint32 getFixedRate(void) const;
+		double getInterpolation(void) const;
+
+		void setIdleEnabled(bool const state);
+		bool isIdleEnabled(void) const;
+		Uint32 getIdleTime(void) const;
+		Uint64 getDisplayedFrames(void) const;
+
 		/* View */
 		void display(void);
 
@@ -34,6 +114,18 @@ class GameContext : public IGameContext
 		void handleEvent(
 			SDL_Event const & event,
 			std::shared_ptr<EngineUpdate> engineUpdate);
+
+		/*
+		 * Dispatches the events batched so far (elapse does it every frame).
+		 * A batch from before another context's frame is dropped : this one
+		 * was covered meanwhile, and the motion is stale.
+		 */
+		void flushEvents(EngineUpdate & engineUpdate);
+		static bool isBatched(SDL_Event const & event);
+
+		/* Off by default : for handlers that only need the latest motion */
+		void setCoalescing(bool const state);
+		bool isCoalescing(void) const;
 };
 
 #endif // GAME_CONTEXT_HPP_INCLUDED
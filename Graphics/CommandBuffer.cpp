@@ -0,0 +1,381 @@
+#include "CommandBuffer.hpp"
+#include <algorithm>
+#include <numeric>
+
+CommandBuffer::CommandBuffer(void) :
+	_renderer(nullptr),
+	_enabled(true),
+	_recording(false),
+	_base(0),
+	_layer(0),
+	_firstCommand(0),
+	_firstVertex(0),
+	_firstIndex(0),
+	_submittedCommands(0),
+	_submittedCalls(0)
+{}
+
+std::shared_ptr<CommandBuffer> CommandBuffer::getInstance(void)
+{
+	static std::shared_ptr<CommandBuffer> instance(new CommandBuffer);
+	return instance;
+}
+
+void CommandBuffer::setEnabled(bool const state)
+{
+	flush();
+	_enabled = state;
+}
+
+void CommandBuffer::toggle(void)
+{
+	setEnabled(!_enabled);
+}
+
+bool CommandBuffer::isEnabled(void) const
+{
+	return _enabled;
+}
+
+void CommandBuffer::begin(SDL_Renderer * renderer)
+{
+	flush();
+
+	_renderer = renderer;
+	_recording = (_enabled && renderer);
+	_base = 0;
+	_layer = 0;
+	_bases.clear();
+	_submittedCommands = 0;
+	_submittedCalls = 0;
+}
+
+bool CommandBuffer::isRecording(void) const
+{
+	return _recording;
+}
+
+void CommandBuffer::beginNested(SDL_Renderer * renderer)
+{
+	_frames.push_back({ _renderer, _recording, _base, _layer, _bases,
+		_firstCommand, _firstVertex, _firstIndex,
+		_submittedCommands, _submittedCalls });
+
+	_renderer = renderer;
+	_recording = (_enabled && renderer);
+	_base = 0;
+	_layer = 0;
+	_bases.clear();
+	_firstCommand = _commands.size();
+	_firstVertex = _vertices.size();
+	_firstIndex = _indices.size();
+}
+
+void CommandBuffer::endNested(void)
+{
+	flush();
+	if (_frames.empty())
+		return;
+
+	Frame & frame(_frames.back());
+	_renderer = frame.renderer;
+	_recording = frame.recording;
+	_base = frame.base;
+	_layer = frame.layer;
+	_bases.swap(frame.bases);
+	_firstCommand = frame.firstCommand;
+	_firstVertex = frame.firstVertex;
+	_firstIndex = frame.firstIndex;
+	_submittedCommands = frame.submittedCommands;
+	_submittedCalls = frame.submittedCalls;
+	_frames.pop_back();
+}
+
+void CommandBuffer::pushLayer(void)
+{
+	_bases.push_back(_base);
+	_base += LAYERS_PER_VIEW;
+	_layer = _base;
+}
+
+void CommandBuffer::popLayer(void)
+{
+	if (_bases.empty())
+		return;
+
+	_base = _bases.back();
+	_bases.pop_back();
+	_layer = _base;
+}
+
+void CommandBuffer::setLayer(Uint32 const layer)
+{
+	_layer = _base + layer;
+}
+
+bool CommandBuffer::records(SDL_Renderer * renderer) const
+{
+	return _recording && renderer == _renderer;
+}
+
+CommandBuffer::Command CommandBuffer::makeCommand(Type const type,
+	SDL_Color const & color) const
+{
+	Command command{};
+
+	command.layer = _layer;
+	command.type = type;
+	command.blend = SDL_BLENDMODE_BLEND;
+	command.color = color;
+
+	return command;
+}
+
+void CommandBuffer::add(SDL_Renderer * renderer, Command const & command)
+{
+	if (!renderer)
+		return;
+
+	_commands.push_back(command);
+	if (records(renderer))
+		return;
+
+	/* Immediate mode : run it on the spot */
+	_order.assign(1, static_cast<Uint32>(_commands.size() - 1));
+	execute(renderer, 0, 1);
+	_order.clear();
+
+	_commands.pop_back();
+	if (command.type == GEOMETRY)
+	{
+		_vertices.resize(command.firstVertex);
+		_indices.resize(command.firstIndex);
+	}
+}
+
+void CommandBuffer::fill(SDL_Renderer * renderer, SDL_Color const & color)
+{
+	add(renderer, makeCommand(FILL, color));
+}
+
+void CommandBuffer::fillRect(SDL_Renderer * renderer,
+	SDL_Color const & color,
+	SDL_Rect const & rect)
+{
+	Command command(makeCommand(FILL_RECT, color));
+	command.rect = rect;
+	add(renderer, command);
+}
+
+void CommandBuffer::drawRect(SDL_Renderer * renderer,
+	SDL_Color const & color,
+	SDL_Rect const & rect)
+{
+	Command command(makeCommand(DRAW_RECT, color));
+	command.rect = rect;
+	add(renderer, command);
+}
+
+void CommandBuffer::drawLine(SDL_Renderer * renderer,
+	SDL_Color const & color,
+	int const x1, int const y1, int const x2, int const y2)
+{
+	Command command(makeCommand(DRAW_LINE, color));
+	command.rect = { x1, y1, x2, y2 };
+	add(renderer, command);
+}
+
+void CommandBuffer::geometry(SDL_Renderer * renderer,
+	SDL_Texture * texture,
+	SDL_Vertex const * vertices, int const vertexCount,
+	int const * indices, int const indexCount)
+{
+	Command command(makeCommand(GEOMETRY, { 255, 255, 255, 255 }));
+
+	if (texture)
+		SDL_GetTextureBlendMode(texture, &command.blend);
+	command.texture = texture;
+	command.firstVertex = static_cast<int>(_vertices.size());
+	command.vertexCount = vertexCount;
+	command.firstIndex = static_cast<int>(_indices.size());
+	command.indexCount = indexCount;
+
+	_vertices.insert(_vertices.end(), vertices, vertices + vertexCount);
+	_indices.insert(_indices.end(), indices, indices + indexCount);
+	add(renderer, command);
+}
+
+void CommandBuffer::copyEx(SDL_Renderer * renderer,
+	SDL_Texture * texture,
+	SDL_Rect const * clip,
+	SDL_Rect const & destination,
+	double const angle,
+	SDL_Point const & center,
+	SDL_RendererFlip const flip)
+{
+	Command command(makeCommand(COPY_EX, { 255, 255, 255, 255 }));
+
+	if (!texture)
+		return;
+
+	SDL_GetTextureBlendMode(texture, &command.blend);
+	command.texture = texture;
+	command.rect = destination;
+	command.clipped = (clip != nullptr);
+	if (clip)
+		command.clip = *clip;
+	command.angle = angle;
+	command.center = center;
+	command.flip = flip;
+
+	add(renderer, command);
+}
+
+/* Neighbours after sorting that one SDL call can draw together */
+bool CommandBuffer::isMergeable(Command const & a, Command const & b)
+{
+	if (a.type != b.type || a.texture != b.texture || a.blend != b.blend)
+		return false;
+
+	switch (a.type)
+	{
+		case GEOMETRY:
+		return true;
+
+		case FILL_RECT:
+		case DRAW_RECT:
+		return a.color.r == b.color.r && a.color.g == b.color.g
+			&& a.color.b == b.color.b && a.color.a == b.color.a;
+
+		default:
+		return false;
+	}
+}
+
+void CommandBuffer::setDrawState(SDL_Renderer * renderer, Command const & command)
+{
+	SDL_SetRenderDrawBlendMode(renderer, command.blend);
+	SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g,
+		command.color.b, command.color.a);
+}
+
+/* Draws _order[first, last), all sharing the first command's state */
+unsigned int CommandBuffer::execute(SDL_Renderer * renderer,
+	std::size_t const first, std::size_t const last)
+{
+	auto const at([this](std::size_t const i) -> Command const &
+	{
+		return _commands[_order[i]];
+	});
+	Command const & command(at(first));
+	unsigned int calls(0);
+
+	switch (command.type)
+	{
+		case FILL:
+			setDrawState(renderer, command);
+			SDL_RenderFillRect(renderer, nullptr);
+			calls = 1;
+		break;
+
+		case FILL_RECT:
+		case DRAW_RECT:
+			_batchRects.clear();
+			for (std::size_t i(first); i < last; ++i)
+				_batchRects.push_back(at(i).rect);
+
+			setDrawState(renderer, command);
+			if (command.type == FILL_RECT)
+				SDL_RenderFillRects(renderer, _batchRects.data(),
+					static_cast<int>(_batchRects.size()));
+			else
+				SDL_RenderDrawRects(renderer, _batchRects.data(),
+					static_cast<int>(_batchRects.size()));
+			calls = 1;
+		break;
+
+		case DRAW_LINE:
+			setDrawState(renderer, command);
+			SDL_RenderDrawLine(renderer, command.rect.x, command.rect.y,
+				command.rect.w, command.rect.h);
+			calls = 1;
+		break;
+
+		case GEOMETRY:
+			_batchVertices.clear();
+			_batchIndices.clear();
+			for (std::size_t i(first); i < last; ++i)
+			{
+				Command const & part(at(i));
+				int const base(static_cast<int>(_batchVertices.size()));
+
+				_batchVertices.insert(_batchVertices.end(),
+					_vertices.begin() + part.firstVertex,
+					_vertices.begin() + part.firstVertex + part.vertexCount);
+				for (int index(0); index < part.indexCount; ++index)
+					_batchIndices.push_back(base + _indices[part.firstIndex + index]);
+			}
+
+			SDL_RenderGeometry(renderer, command.texture,
+				_batchVertices.data(), static_cast<int>(_batchVertices.size()),
+				_batchIndices.data(), static_cast<int>(_batchIndices.size()));
+			calls = 1;
+		break;
+
+		case COPY_EX:
+			SDL_RenderCopyEx(renderer, command.texture,
+				command.clipped ? &command.clip : nullptr, &command.rect,
+				command.angle, &command.center, command.flip);
+			calls = 1;
+		break;
+	}
+
+	return calls;
+}
+
+void CommandBuffer::flush(void)
+{
+	if (!_recording)
+		return;
+	_recording = false;
+
+	/*
+	 * Stable, by layer only : overlapping draws of a layer keep their
+	 * recording order, whatever their state
+	 */
+	_order.resize(_commands.size() - _firstCommand);
+	std::iota(_order.begin(), _order.end(), static_cast<Uint32>(_firstCommand));
+	std::stable_sort(_order.begin(), _order.end(),
+		[this](Uint32 const left, Uint32 const right)
+		{
+			return _commands[left].layer < _commands[right].layer;
+		});
+
+	_submittedCommands = static_cast<unsigned int>(_order.size());
+	_submittedCalls = 0;
+	for (std::size_t first(0); first < _order.size(); )
+	{
+		std::size_t last(first + 1);
+		while (last < _order.size()
+			&& isMergeable(_commands[_order[first]], _commands[_order[last]]))
+			++last;
+
+		_submittedCalls += execute(_renderer, first, last);
+		first = last;
+	}
+
+	_order.clear();
+	_commands.resize(_firstCommand);
+	_vertices.resize(_firstVertex);
+	_indices.resize(_firstIndex);
+}
+
+unsigned int CommandBuffer::getSubmittedCommands(void) const
+{
+	return _submittedCommands;
+}
+
+unsigned int CommandBuffer::getSubmittedCalls(void) const
+{
+	return _submittedCalls;
+}
@@ -0,0 +1,162 @@
+#ifndef COMMAND_BUFFER_HPP_INCLUDED
+#define COMMAND_BUFFER_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <vector>
+
+/* Layers available to one view, relative to its base (see pushLayer) */
+#define LAYER_BACKGROUND 0
+#define LAYER_SPRITES 4
+#define LAYER_SHAPES 8
+#define LAYER_TEXT 12
+#define LAYERS_PER_VIEW 16
+
+/*
+ * Retained draw commands for one frame. While recording, views append small
+ * POD commands instead of drawing ; flush() stable-sorts them by layer, then
+ * merges neighbours sharing texture, blend mode & color into single SDL
+ * calls.
+ *
+ * Within a layer, commands are drawn in recording order : views get the
+ * most merging by recording draws of the same state together. Wrapping views
+ * (Global, Pause) push a new base layer before drawing on top of their
+ * sub-view.
+ *
+ * When not recording (or disabled, or drawing on another renderer),
+ * commands are executed immediately, so views keep a single code path.
+ */
+class CommandBuffer
+{
+	public:
+		enum Type
+		{
+			FILL,
+			FILL_RECT,
+			DRAW_RECT,
+			DRAW_LINE,
+			GEOMETRY,
+			COPY_EX
+		};
+
+		struct Command
+		{
+			Uint32 layer;
+			Type type;
+			SDL_BlendMode blend;
+			SDL_Texture * texture;
+			SDL_Color color;
+
+			/* Destination, or line ends as (x1, y1, x2, y2) */
+			SDL_Rect rect;
+
+			/* COPY_EX */
+			SDL_Rect clip;
+			bool clipped;
+			double angle;
+			SDL_Point center;
+			SDL_RendererFlip flip;
+
+			/* GEOMETRY : ranges in the shared vertex & index arrays */
+			int firstVertex;
+			int vertexCount;
+			int firstIndex;
+			int indexCount;
+		};
+
+	private:
+		/* An enclosing frame, put aside by beginNested() */
+		struct Frame
+		{
+			SDL_Renderer * renderer;
+			bool recording;
+			Uint32 base;
+			Uint32 layer;
+			std::vector<Uint32> bases;
+			std::size_t firstCommand;
+			std::size_t firstVertex;
+			std::size_t firstIndex;
+			unsigned int submittedCommands;
+			unsigned int submittedCalls;
+		};
+
+		SDL_Renderer * _renderer;
+		bool _enabled;
+		bool _recording;
+		Uint32 _base;
+		Uint32 _layer;
+		std::vector<Uint32> _bases;
+		std::vector<Frame> _frames;
+
+		/* The current frame's commands come after the enclosing frames' */
+		std::vector<Command> _commands;
+		std::vector<SDL_Vertex> _vertices;
+		std::vector<int> _indices;
+		std::size_t _firstCommand;
+		std::size_t _firstVertex;
+		std::size_t _firstIndex;
+
+		/* Scratch buffers, kept across frames to avoid per-frame allocation */
+		std::vector<Uint32> _order;
+		std::vector<SDL_Vertex> _batchVertices;
+		std::vector<int> _batchIndices;
+		std::vector<SDL_Rect> _batchRects;
+
+		unsigned int _submittedCommands;
+		unsigned int _submittedCalls;
+
+		CommandBuffer(void);
+
+		bool records(SDL_Renderer * renderer) const;
+		Command makeCommand(Type const type, SDL_Color const & color) const;
+		void add(SDL_Renderer * renderer, Command const & command);
+		unsigned int execute(SDL_Renderer * renderer,
+			std::size_t const first, std::size_t const last);
+
+		static bool isMergeable(Command const & a, Command const & b);
+		static void setDrawState(SDL_Renderer * renderer, Command const & command);
+
+	public:
+		static std::shared_ptr<CommandBuffer> getInstance(void);
+
+		void setEnabled(bool const state);
+		void toggle(void);
+		bool isEnabled(void) const;
+
+		void begin(SDL_Renderer * renderer);
+		void flush(void);
+		bool isRecording(void) const;
+
+		/*
+		 * A frame within the frame (see FreezeFrame), flushed by endNested()
+		 * on its own : the enclosing frame's commands, layers & statistics
+		 * are left as they were.
+		 */
+		void beginNested(SDL_Renderer * renderer);
+		void endNested(void);
+
+		void pushLayer(void);
+		void popLayer(void);
+		void setLayer(Uint32 const layer);
+
+		void fill(SDL_Renderer * renderer, SDL_Color const & color);
+		void fillRect(SDL_Renderer * renderer, SDL_Color const & color,
+			SDL_Rect const & rect);
+		void drawRect(SDL_Renderer * renderer, SDL_Color const & color,
+			SDL_Rect const & rect);
+		void drawLine(SDL_Renderer * renderer, SDL_Color const & color,
+			int const x1, int const y1, int const x2, int const y2);
+		void geometry(SDL_Renderer * renderer, SDL_Texture * texture,
+			SDL_Vertex const * vertices, int const vertexCount,
+			int const * indices, int const indexCount);
+		void copyEx(SDL_Renderer * renderer, SDL_Texture * texture,
+			SDL_Rect const * clip, SDL_Rect const & destination,
+			double const angle, SDL_Point const & center,
+			SDL_RendererFlip const flip);
+
+		/* Last flush : commands recorded & SDL draw calls issued for them */
+		unsigned int getSubmittedCommands(void) const;
+		unsigned int getSubmittedCalls(void) const;
+};
+
+#endif // COMMAND_BUFFER_HPP_INCLUDED
@@ -0,0 +1,118 @@
+#include "FreezeFrame.hpp"
+#include "CommandBuffer.hpp"
+#include <VBN/IView.hpp>
+
+unsigned int FreezeFrame::_currentGeneration(0);
+
+FreezeFrame::FreezeFrame(void) :
+	_renderer(nullptr),
+	_texture(nullptr),
+	_width(0),
+	_height(0),
+	_generation(0)
+{}
+
+FreezeFrame::~FreezeFrame(void)
+{
+	release();
+}
+
+bool FreezeFrame::allocate(SDL_Renderer * renderer, int const width, int const height)
+{
+	release();
+
+	_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_TARGET, width, height);
+	if (!_texture)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+			"Cannot allocate freeze frame target : %s",
+			SDL_GetError());
+		return false;
+	}
+
+	/* Opaque : the snapshot replaces everything beneath it */
+	SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_NONE);
+
+	_renderer = renderer;
+	_width = width;
+	_height = height;
+
+	return true;
+}
+
+void FreezeFrame::release(void)
+{
+	if (_texture)
+		SDL_DestroyTexture(_texture);
+
+	_renderer = nullptr;
+	_texture = nullptr;
+	_width = 0;
+	_height = 0;
+}
+
+/* Views draw in logical coordinates when the window has a logical size */
+void FreezeFrame::getAreaSize(SDL_Renderer * renderer, int & width, int & height)
+{
+	SDL_RenderGetLogicalSize(renderer, &width, &height);
+	if (!width || !height)
+		SDL_GetRendererOutputSize(renderer, &width, &height);
+}
+
+bool FreezeFrame::isValid(SDL_Renderer * renderer) const
+{
+	int width(0), height(0);
+
+	if (!_texture || renderer != _renderer || _generation != _currentGeneration)
+		return false;
+
+	getAreaSize(renderer, width, height);
+	return width == _width && height == _height;
+}
+
+bool FreezeFrame::capture(SDL_Renderer * renderer, IView & view, SDL_Color const & tint)
+{
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	int width(0), height(0);
+
+	if (!renderer || !SDL_RenderTargetSupported(renderer))
+		return false;
+
+	getAreaSize(renderer, width, height);
+	if ((!_texture || renderer != _renderer || width != _width || height != _height)
+		&& !allocate(renderer, width, height))
+		return false;
+
+	SDL_Texture * previousTarget(SDL_GetRenderTarget(renderer));
+	SDL_SetRenderTarget(renderer, _texture);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+	SDL_RenderClear(renderer);
+
+	/* What the frame recorded so far stays pending, out of the snapshot */
+	commands->beginNested(renderer);
+	view.display();
+	commands->pushLayer();
+	commands->fill(renderer, tint);
+	commands->popLayer();
+	commands->endNested();
+
+	SDL_SetRenderTarget(renderer, previousTarget);
+
+	_generation = _currentGeneration;
+	return true;
+}
+
+void FreezeFrame::display(SDL_Renderer * renderer)
+{
+	if (!_texture)
+		return;
+
+	CommandBuffer::getInstance()->copyEx(renderer, _texture, nullptr,
+		{ 0, 0, _width, _height }, 0., { _width / 2, _height / 2 }, SDL_FLIP_NONE);
+}
+
+void FreezeFrame::invalidateAll(void)
+{
+	++_currentGeneration;
+}
@@ -0,0 +1,44 @@
+#ifndef FREEZE_FRAME_HPP_INCLUDED
+#define FREEZE_FRAME_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+
+class IView;
+
+/*
+ * Snapshot of a view rendered once into a target texture, optionally tinted,
+ * for contexts pushed over another one : the covered view is drawn a single
+ * time instead of every frame. Snapshots are retaken after render targets
+ * were lost (see invalidateAll) or the drawing area changed size.
+ */
+class FreezeFrame
+{
+	private:
+		SDL_Renderer * _renderer;
+		SDL_Texture * _texture;
+		int _width;
+		int _height;
+		unsigned int _generation;
+
+		static unsigned int _currentGeneration;
+
+		bool allocate(SDL_Renderer * renderer, int const width, int const height);
+		void release(void);
+
+		static void getAreaSize(SDL_Renderer * renderer, int & width, int & height);
+
+	public:
+		FreezeFrame(void);
+		~FreezeFrame(void);
+
+		FreezeFrame(FreezeFrame const &) = delete;
+		FreezeFrame & operator=(FreezeFrame const &) = delete;
+
+		bool isValid(SDL_Renderer * renderer) const;
+		bool capture(SDL_Renderer * renderer, IView & view, SDL_Color const & tint);
+		void display(SDL_Renderer * renderer);
+
+		static void invalidateAll(void);
+};
+
+#endif // FREEZE_FRAME_HPP_INCLUDED
@@ -0,0 +1,411 @@
+#include "GlyphAtlas.hpp"
+#include "RendererAccess.hpp"
+#include "CommandBuffer.hpp"
+#include <VBN/Window.hpp>
+#include <algorithm>
+#include <climits>
+
+/* ------------------------------------------------ */
+/* ------------------ GLYPH ATLAS ----------------- */
+/* ------------------------------------------------ */
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer * renderer, TTF_Font * font) :
+	_renderer(renderer),
+	_font(font),
+	_lineSkip(TTF_FontLineSkip(font)),
+	_shelfX(1), _shelfY(1), _shelfHeight(0)
+{}
+
+GlyphAtlas::~GlyphAtlas(void)
+{
+	for (SDL_Texture * page : _pages)
+		SDL_DestroyTexture(page);
+
+	TTF_CloseFont(_font);
+}
+
+bool GlyphAtlas::addPage(void)
+{
+	SDL_Texture * page(SDL_CreateTexture(_renderer,
+		SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_STATIC,
+		GLYPH_ATLAS_PAGE_SIZE,
+		GLYPH_ATLAS_PAGE_SIZE));
+
+	if (!page)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+			"Cannot allocate glyph atlas page : %s",
+			SDL_GetError());
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+	_pages.push_back(page);
+	_vertices.emplace_back();
+	_indices.emplace_back();
+
+	_shelfX = 1;
+	_shelfY = 1;
+	_shelfHeight = 0;
+
+	return true;
+}
+
+GlyphAtlas::Glyph const * GlyphAtlas::rasterize(Uint32 const codepoint)
+{
+	Glyph glyph{ 0, { 0, 0, 0, 0 }, 0 };
+	int minX(0), maxX(0), minY(0), maxY(0);
+	SDL_Surface * surface(nullptr);
+
+	/* Unknown codepoints share the '?' glyph */
+	if (!TTF_GlyphIsProvided32(_font, codepoint))
+	{
+		if (codepoint != '?')
+		{
+			Glyph const * fallback(getGlyph('?'));
+			if (fallback)
+				glyph = *fallback;
+		}
+		return &(_glyphs[codepoint] = glyph);
+	}
+
+	TTF_GlyphMetrics32(_font, codepoint,
+		&minX, &maxX, &minY, &maxY, &glyph.advance);
+
+	/* Whitespace only needs its advance */
+	if (codepoint == ' ' || codepoint == '\t')
+		return &(_glyphs[codepoint] = glyph);
+
+	surface = TTF_RenderGlyph32_Blended(_font, codepoint,
+		SDL_Color{ 255, 255, 255, 255 });
+	if (surface && surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+	{
+		SDL_Surface * converted(SDL_ConvertSurfaceFormat(surface,
+			SDL_PIXELFORMAT_ARGB8888, 0));
+		SDL_FreeSurface(surface);
+		surface = converted;
+	}
+	if (!surface)
+		return &(_glyphs[codepoint] = glyph);
+
+	if (surface->w + 2 > GLYPH_ATLAS_PAGE_SIZE
+		|| surface->h + 2 > GLYPH_ATLAS_PAGE_SIZE)
+	{
+		SDL_FreeSurface(surface);
+		return &(_glyphs[codepoint] = glyph);
+	}
+
+	/* Shelf packing, 1 texel of padding around every glyph */
+	if (_shelfX + surface->w + 1 > GLYPH_ATLAS_PAGE_SIZE)
+	{
+		_shelfX = 1;
+		_shelfY += _shelfHeight + 1;
+		_shelfHeight = 0;
+	}
+	if ((_pages.empty() || _shelfY + surface->h + 1 > GLYPH_ATLAS_PAGE_SIZE)
+		&& !addPage())
+	{
+		SDL_FreeSurface(surface);
+		return &(_glyphs[codepoint] = glyph);
+	}
+
+	glyph.page = static_cast<int>(_pages.size()) - 1;
+	glyph.clip = { _shelfX, _shelfY, surface->w, surface->h };
+	SDL_UpdateTexture(_pages.back(), &glyph.clip,
+		surface->pixels, surface->pitch);
+
+	_shelfX += surface->w + 1;
+	_shelfHeight = std::max(_shelfHeight, surface->h);
+	SDL_FreeSurface(surface);
+
+	return &(_glyphs[codepoint] = glyph);
+}
+
+GlyphAtlas::Glyph const * GlyphAtlas::getGlyph(Uint32 const codepoint)
+{
+	std::unordered_map<Uint32, Glyph>::const_iterator it(_glyphs.find(codepoint));
+
+	if (it != _glyphs.end())
+		return &(it->second);
+
+	return rasterize(codepoint);
+}
+
+int GlyphAtlas::getLineSkip(void) const
+{
+	return _lineSkip;
+}
+
+int GlyphAtlas::measure(std::string const & text)
+{
+	int width(0), lineWidth(0);
+
+	decodeUTF8(text, _codepoints);
+	for (Uint32 codepoint : _codepoints)
+	{
+		if (codepoint == '\n')
+		{
+			lineWidth = 0;
+			continue;
+		}
+
+		Glyph const * glyph(getGlyph(codepoint));
+		if (glyph)
+			lineWidth += glyph->advance;
+		width = std::max(width, lineWidth);
+	}
+
+	return width;
+}
+
+void GlyphAtlas::pushQuad(Glyph const & glyph, float const x, float const y,
+	SDL_Color const & color)
+{
+	std::vector<SDL_Vertex> & vertices(_vertices[glyph.page]);
+	std::vector<int> & indices(_indices[glyph.page]);
+	int const base(static_cast<int>(vertices.size()));
+	float const scale(1.f / GLYPH_ATLAS_PAGE_SIZE);
+
+	float const u0(glyph.clip.x * scale), v0(glyph.clip.y * scale);
+	float const u1((glyph.clip.x + glyph.clip.w) * scale);
+	float const v1((glyph.clip.y + glyph.clip.h) * scale);
+	float const w(static_cast<float>(glyph.clip.w));
+	float const h(static_cast<float>(glyph.clip.h));
+
+	vertices.push_back({ { x, y }, color, { u0, v0 } });
+	vertices.push_back({ { x + w, y }, color, { u1, v0 } });
+	vertices.push_back({ { x + w, y + h }, color, { u1, v1 } });
+	vertices.push_back({ { x, y + h }, color, { u0, v1 } });
+
+	indices.insert(indices.end(),
+		{ base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+/* Quads are only pushed given a color : without one, rows are just counted */
+int GlyphAtlas::layout(std::string const & text, SDL_Color const * color,
+	SDL_Rect const & area)
+{
+	int penX(0), penY(0);
+	std::size_t i(0);
+
+	decodeUTF8(text, _codepoints);
+
+	/* Greedy word wrapping inside area, clipped to its height */
+	while (i < _codepoints.size() && penY + _lineSkip <= area.h)
+	{
+		Uint32 const codepoint(_codepoints[i]);
+
+		if (codepoint == '\n')
+		{
+			penX = 0;
+			penY += _lineSkip;
+			++i;
+			continue;
+		}
+
+		/* At the start of a word, wrap if the whole word does not fit */
+		if (codepoint != ' ' && penX > 0
+			&& (_codepoints[i - 1] == ' ' || _codepoints[i - 1] == '\n'))
+		{
+			int wordWidth(0);
+			for (std::size_t j(i); j < _codepoints.size()
+				&& _codepoints[j] != ' ' && _codepoints[j] != '\n'; ++j)
+			{
+				Glyph const * glyph(getGlyph(_codepoints[j]));
+				if (glyph)
+					wordWidth += glyph->advance;
+			}
+
+			if (penX + wordWidth > area.w)
+			{
+				penX = 0;
+				penY += _lineSkip;
+				continue;
+			}
+		}
+
+		Glyph const * glyph(getGlyph(codepoint));
+		if (!glyph)
+		{
+			++i;
+			continue;
+		}
+
+		/* Words wider than the area are broken between characters */
+		if (penX > 0 && penX + glyph->advance > area.w)
+		{
+			if (codepoint == ' ')
+				++i;
+			else
+			{
+				penX = 0;
+				penY += _lineSkip;
+			}
+			continue;
+		}
+
+		if (color && glyph->clip.w > 0)
+			pushQuad(*glyph,
+				static_cast<float>(area.x + penX),
+				static_cast<float>(area.y + penY),
+				*color);
+
+		penX += glyph->advance;
+		++i;
+	}
+
+	return penY / _lineSkip + 1;
+}
+
+int GlyphAtlas::getRows(std::string const & text, int const width)
+{
+	return layout(text, nullptr, { 0, 0, width, INT_MAX });
+}
+
+void GlyphAtlas::printText(std::string const & text,
+	SDL_Color const & color,
+	SDL_Rect const & area)
+{
+	for (std::size_t page(0); page < _pages.size(); ++page)
+	{
+		_vertices[page].clear();
+		_indices[page].clear();
+	}
+
+	layout(text, &color, area);
+
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	for (std::size_t page(0); page < _pages.size(); ++page)
+	{
+		if (_indices[page].empty())
+			continue;
+
+		commands->geometry(_renderer, _pages[page],
+			_vertices[page].data(), static_cast<int>(_vertices[page].size()),
+			_indices[page].data(), static_cast<int>(_indices[page].size()));
+	}
+}
+
+void GlyphAtlas::decodeUTF8(std::string const & text,
+	std::vector<Uint32> & codepoints)
+{
+	std::size_t i(0);
+
+	codepoints.clear();
+	while (i < text.size())
+	{
+		unsigned char const lead(static_cast<unsigned char>(text[i]));
+		Uint32 codepoint(lead);
+		std::size_t length(1);
+
+		if (lead >= 0xF0)
+		{
+			codepoint = lead & 0x07;
+			length = 4;
+		}
+		else if (lead >= 0xE0)
+		{
+			codepoint = lead & 0x0F;
+			length = 3;
+		}
+		else if (lead >= 0xC0)
+		{
+			codepoint = lead & 0x1F;
+			length = 2;
+		}
+		else if (lead >= 0x80)
+			codepoint = '?';
+
+		if (i + length > text.size())
+		{
+			codepoints.push_back('?');
+			break;
+		}
+
+		for (std::size_t j(1); j < length; ++j)
+			codepoint = (codepoint << 6)
+				| (static_cast<unsigned char>(text[i + j]) & 0x3F);
+
+		codepoints.push_back(codepoint);
+		i += length;
+	}
+}
+
+/* ------------------------------------------------ */
+/* ------------------ TEXT CACHE ------------------ */
+/* ------------------------------------------------ */
+
+TextCache::TextCache(void) : _fontDirectory("assets/fonts/")
+{}
+
+std::shared_ptr<TextCache> TextCache::getInstance(void)
+{
+	static std::shared_ptr<TextCache> instance(new TextCache);
+	return instance;
+}
+
+void TextCache::setFontDirectory(std::string const & directory)
+{
+	_fontDirectory = directory;
+}
+
+/* In-memory font file : opening it then costs no disk access */
+void TextCache::addFontData(std::string const & font, Blob const & data)
+{
+	_fontData[font] = data;
+}
+
+GlyphAtlas * TextCache::getAtlas(SDL_Renderer * renderer,
+	std::string const & font,
+	unsigned int const size)
+{
+	std::tuple<SDL_Renderer *, std::string, unsigned int> key(renderer, font, size);
+	auto it(_atlases.find(key));
+
+	if (it != _atlases.end())
+		return it->second.get();
+
+	/* Failures are cached too, so a missing font is only reported once */
+	std::unique_ptr<GlyphAtlas> & atlas(_atlases[key]);
+	auto const data(_fontData.find(font));
+	TTF_Font * ttf(nullptr);
+
+	if (data != _fontData.end())
+		ttf = TTF_OpenFontRW(SDL_RWFromConstMem(data->second.data.get(),
+			static_cast<int>(data->second.size)), 1, static_cast<int>(size));
+	else
+		ttf = TTF_OpenFont((_fontDirectory + font + ".ttf").c_str(),
+			static_cast<int>(size));
+
+	if (ttf)
+		atlas.reset(new GlyphAtlas(renderer, ttf));
+	else
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+			"Cannot open font \"%s\" (%upt) : %s",
+			font.c_str(), size, TTF_GetError());
+
+	return atlas.get();
+}
+
+void TextCache::printText(Window * window,
+	std::string const & text,
+	std::string const & font,
+	unsigned int const size,
+	SDL_Color const & color,
+	SDL_Rect const & area)
+{
+	SDL_Renderer * renderer(getSDLRenderer(window));
+	GlyphAtlas * atlas(nullptr);
+
+	if (renderer)
+		atlas = getAtlas(renderer, font, size);
+	if (atlas)
+		atlas->printText(text, color, area);
+}
+
+void TextCache::clear(void)
+{
+	_atlases.clear();
+	_fontData.clear();
+}
@@ -0,0 +1,109 @@
+#ifndef GLYPH_ATLAS_HPP_INCLUDED
+#define GLYPH_ATLAS_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "../System/Blob.hpp"
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#define GLYPH_ATLAS_PAGE_SIZE 512
+
+class Window;
+
+/*
+ * A single font face at a single point size. Each codepoint is rasterized
+ * once, on first use, into a shelf-packed atlas page; text is then laid out
+ * as textured quads and submitted with one SDL_RenderGeometry per page.
+ */
+class GlyphAtlas
+{
+	public:
+		struct Glyph
+		{
+			int page;
+			SDL_Rect clip;
+			int advance;
+		};
+
+	private:
+		SDL_Renderer * _renderer;
+		TTF_Font * _font;
+		int _lineSkip;
+
+		std::vector<SDL_Texture *> _pages;
+		int _shelfX;
+		int _shelfY;
+		int _shelfHeight;
+		std::unordered_map<Uint32, Glyph> _glyphs;
+
+		/* Scratch buffers, kept across calls to avoid per-frame allocation */
+		std::vector<Uint32> _codepoints;
+		std::vector<std::vector<SDL_Vertex>> _vertices;
+		std::vector<std::vector<int>> _indices;
+
+		bool addPage(void);
+		Glyph const * rasterize(Uint32 const codepoint);
+		void pushQuad(Glyph const & glyph, float const x, float const y,
+			SDL_Color const & color);
+		int layout(std::string const & text, SDL_Color const * color,
+			SDL_Rect const & area);
+
+	public:
+		GlyphAtlas(SDL_Renderer * renderer, TTF_Font * font);
+		~GlyphAtlas(void);
+
+		Glyph const * getGlyph(Uint32 const codepoint);
+		int getLineSkip(void) const;
+		int measure(std::string const & text);
+
+		/* Rows printText takes for <text> in <width> pixels, at least one */
+		int getRows(std::string const & text, int const width);
+
+		void printText(std::string const & text,
+			SDL_Color const & color,
+			SDL_Rect const & area);
+
+		static void decodeUTF8(std::string const & text,
+			std::vector<Uint32> & codepoints);
+};
+
+/*
+ * Process-wide registry of glyph atlases, one per (renderer, font, size).
+ * Font files are looked up as <font directory>/<name>.ttf, the same layout
+ * TrueTypeFontManager uses, unless the AssetLoader already read them.
+ */
+class TextCache
+{
+	private:
+		std::string _fontDirectory;
+		std::map<std::string, Blob> _fontData;
+		std::map<std::tuple<SDL_Renderer *, std::string, unsigned int>,
+			std::unique_ptr<GlyphAtlas>> _atlases;
+
+		TextCache(void);
+
+	public:
+		static std::shared_ptr<TextCache> getInstance(void);
+
+		void setFontDirectory(std::string const & directory);
+		void addFontData(std::string const & font, Blob const & data);
+		GlyphAtlas * getAtlas(SDL_Renderer * renderer,
+			std::string const & font,
+			unsigned int const size);
+
+		void printText(Window * window,
+			std::string const & text,
+			std::string const & font,
+			unsigned int const size,
+			SDL_Color const & color,
+			SDL_Rect const & area);
+
+		void clear(void);
+};
+
+#endif // GLYPH_ATLAS_HPP_INCLUDED
@@ -0,0 +1,16 @@
+#ifndef I_INTERPOLABLE_HPP_INCLUDED
+#define I_INTERPOLABLE_HPP_INCLUDED
+
+/*
+ * Implemented by views whose model runs at a fixed simulation rate. Before
+ * each display, the owning GameContext reports how far (in [0, 1)) the
+ * render time lies between the last two simulation steps.
+ */
+class IInterpolable
+{
+	public:
+		virtual ~IInterpolable(void) {}
+		virtual void setInterpolation(double const alpha) = 0;
+};
+
+#endif // I_INTERPOLABLE_HPP_INCLUDED
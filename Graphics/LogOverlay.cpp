@@ -0,0 +1,251 @@
+#include "LogOverlay.hpp"
+#include "GlyphAtlas.hpp"
+#include "RendererAccess.hpp"
+#include "../System/LogRing.hpp"
+#include <algorithm>
+#include <utility>
+
+#define LOG_FONT "courier"
+#define LOG_FONT_SIZE 12
+
+LogOverlay::LogOverlay(void) :
+	_renderer(nullptr),
+	_front(nullptr),
+	_back(nullptr),
+	_width(0),
+	_height(0),
+	_drawnSequence(0),
+	_valid(false)
+{}
+
+std::shared_ptr<LogOverlay> LogOverlay::getInstance(void)
+{
+	static std::shared_ptr<LogOverlay> instance(new LogOverlay);
+	return instance;
+}
+
+bool LogOverlay::allocate(SDL_Renderer * renderer, int const width, int const height)
+{
+	release();
+
+	if (!SDL_RenderTargetSupported(renderer))
+		return false;
+
+	_front = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_TARGET, width, height);
+	_back = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_TARGET, width, height);
+
+	if (!_front || !_back)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+			"Cannot allocate log overlay targets : %s",
+			SDL_GetError());
+		release();
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(_front, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureBlendMode(_back, SDL_BLENDMODE_BLEND);
+
+	_renderer = renderer;
+	_width = width;
+	_height = height;
+	_valid = false;
+
+	return true;
+}
+
+void LogOverlay::release(void)
+{
+	if (_front)
+		SDL_DestroyTexture(_front);
+	if (_back)
+		SDL_DestroyTexture(_back);
+
+	_front = nullptr;
+	_back = nullptr;
+	_renderer = nullptr;
+	_valid = false;
+}
+
+/* A line gone from the ring still takes its row */
+int LogOverlay::getRows(GlyphAtlas * atlas, Uint64 const sequence, int const width)
+{
+	if (!LogRing::getInstance()->getLine(sequence, _line))
+		return 1;
+
+	return atlas->getRows(_line, width);
+}
+
+/*
+ * Oldest line from which [first, last] fits in <rows> once wrapped, <used>
+ * of them. The last line is always taken, even taller than the area.
+ */
+Uint64 LogOverlay::fitLines(GlyphAtlas * atlas, Uint64 const last, int const rows,
+	int const width, int & used)
+{
+	Uint64 const oldest(std::max<Uint64>(LogRing::getInstance()->getFirstSequence(), 1));
+	Uint64 first(last);
+
+	used = 0;
+	if (last < oldest)
+		return last + 1;
+
+	used = getRows(atlas, last, width);
+	while (first > oldest)
+	{
+		int const lineRows(getRows(atlas, first - 1, width));
+		if (used + lineRows > rows)
+			break;
+		used += lineRows;
+		--first;
+	}
+
+	return first;
+}
+
+void LogOverlay::drawLines(GlyphAtlas * atlas, Uint64 const first, Uint64 const last,
+	SDL_Rect const & area, int const firstRow, int const lineSkip)
+{
+	std::shared_ptr<LogRing> ring(LogRing::getInstance());
+	int row(firstRow);
+
+	for (Uint64 sequence(first); sequence <= last; ++sequence)
+	{
+		if (!ring->getLine(sequence, _line))
+		{
+			++row;
+			continue;
+		}
+
+		int const lineRows(atlas->getRows(_line, area.w));
+		atlas->printText(_line, { 255, 255, 255, 255 },
+			{ area.x, area.y + row * lineSkip, area.w, lineRows * lineSkip });
+		row += lineRows;
+	}
+}
+
+void LogOverlay::update(void)
+{
+	std::shared_ptr<LogRing> ring(LogRing::getInstance());
+	Uint64 const last(ring->getLastSequence());
+	GlyphAtlas * atlas(nullptr);
+
+	if (_valid && last == _drawnSequence)
+		return;
+
+	atlas = TextCache::getInstance()->getAtlas(_renderer, LOG_FONT, LOG_FONT_SIZE);
+	if (!atlas)
+		return;
+
+	int const lineSkip(std::max(atlas->getLineSkip(), 1));
+	int const rows(_height / lineSkip);
+	Uint64 const newLines(last - _drawnSequence);
+
+	/* Rows the new lines take : scrolling by as many is worth it below <rows> */
+	int newRows(rows);
+	if (_valid && newLines < static_cast<Uint64>(rows))
+	{
+		newRows = 0;
+		for (Uint64 sequence(_drawnSequence + 1); sequence <= last && newRows < rows;
+			++sequence)
+			newRows += getRows(atlas, sequence, _width);
+	}
+
+	SDL_Texture * previousTarget(SDL_GetRenderTarget(_renderer));
+	SDL_BlendMode previousBlend(SDL_BLENDMODE_NONE);
+	Uint8 r(0), g(0), b(0), a(0);
+	SDL_GetRenderDrawColor(_renderer, &r, &g, &b, &a);
+	SDL_GetRenderDrawBlendMode(_renderer, &previousBlend);
+
+	if (newRows >= rows)
+	{
+		/* Full redraw, bottom-aligned on the most recent line */
+		int used(0);
+		Uint64 const first(fitLines(atlas, last, rows, _width, used));
+
+		SDL_SetRenderTarget(_renderer, _front);
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
+		SDL_RenderClear(_renderer);
+		if (last >= first)
+			drawLines(atlas, first, last, { 0, 0, _width, _height },
+				rows - used, lineSkip);
+	}
+	else
+	{
+		/* Scroll the previous contents up and append the new rows */
+		int const shift(newRows * lineSkip);
+		SDL_Rect const source{ 0, shift, _width, _height - shift };
+		SDL_Rect const destination{ 0, 0, _width, _height - shift };
+
+		SDL_SetRenderTarget(_renderer, _back);
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 0);
+		SDL_RenderClear(_renderer);
+
+		SDL_SetTextureBlendMode(_front, SDL_BLENDMODE_NONE);
+		SDL_RenderCopy(_renderer, _front, &source, &destination);
+		SDL_SetTextureBlendMode(_front, SDL_BLENDMODE_BLEND);
+
+		drawLines(atlas, _drawnSequence + 1, last, { 0, 0, _width, _height },
+			rows - newRows, lineSkip);
+		std::swap(_front, _back);
+	}
+
+	SDL_SetRenderTarget(_renderer, previousTarget);
+	SDL_SetRenderDrawColor(_renderer, r, g, b, a);
+	SDL_SetRenderDrawBlendMode(_renderer, previousBlend);
+
+	_drawnSequence = last;
+	_valid = true;
+}
+
+void LogOverlay::drawDirect(SDL_Renderer * renderer, SDL_Rect const & area)
+{
+	GlyphAtlas * atlas(TextCache::getInstance()->getAtlas(renderer,
+		LOG_FONT, LOG_FONT_SIZE));
+
+	if (!atlas)
+		return;
+
+	/* No render target support : lay the visible rows out every frame */
+	int const lineSkip(std::max(atlas->getLineSkip(), 1));
+	int const rows(area.h / lineSkip);
+	Uint64 const last(LogRing::getInstance()->getLastSequence());
+	int used(0);
+	Uint64 const first(fitLines(atlas, last, rows, area.w, used));
+
+	/* Nothing above the area : a line taller than it shows its top only */
+	if (last >= first)
+		drawLines(atlas, first, last, area, std::max(rows - used, 0), lineSkip);
+}
+
+void LogOverlay::display(Window * window, SDL_Rect const & area)
+{
+	SDL_Renderer * renderer(getSDLRenderer(window));
+
+	if (!renderer)
+		return;
+
+	if ((renderer != _renderer || area.w != _width || area.h != _height)
+		&& !allocate(renderer, area.w, area.h))
+	{
+		drawDirect(renderer, area);
+		return;
+	}
+
+	update();
+	SDL_RenderCopy(_renderer, _front, nullptr, &area);
+}
+
+void LogOverlay::invalidate(void)
+{
+	_valid = false;
+}
+
+void LogOverlay::clear(void)
+{
+	release();
+	_width = 0;
+	_height = 0;
+}
@@ -0,0 +1,51 @@
+#ifndef LOG_OVERLAY_HPP_INCLUDED
+#define LOG_OVERLAY_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+
+class Window;
+class GlyphAtlas;
+
+/*
+ * Log overlay kept in a persistent render target. New LogRing lines are
+ * appended by scrolling the previous contents up (ping-ponging between two
+ * targets) and drawing only the new rows, so a frame without new logs costs
+ * a single texture copy. Lines longer than the overlay is wide wrap over
+ * as many rows as they need.
+ */
+class LogOverlay
+{
+	private:
+		SDL_Renderer * _renderer;
+		SDL_Texture * _front;
+		SDL_Texture * _back;
+		int _width;
+		int _height;
+
+		Uint64 _drawnSequence;
+		bool _valid;
+		std::string _line;
+
+		LogOverlay(void);
+
+		bool allocate(SDL_Renderer * renderer, int const width, int const height);
+		void release(void);
+		void update(void);
+		int getRows(GlyphAtlas * atlas, Uint64 const sequence, int const width);
+		Uint64 fitLines(GlyphAtlas * atlas, Uint64 const last, int const rows,
+			int const width, int & used);
+		void drawLines(GlyphAtlas * atlas, Uint64 const first, Uint64 const last,
+			SDL_Rect const & area, int const firstRow, int const lineSkip);
+		void drawDirect(SDL_Renderer * renderer, SDL_Rect const & area);
+
+	public:
+		static std::shared_ptr<LogOverlay> getInstance(void);
+
+		void display(Window * window, SDL_Rect const & area);
+		void invalidate(void);
+		void clear(void);
+};
+
+#endif // LOG_OVERLAY_HPP_INCLUDED
@@ -0,0 +1,19 @@
+#ifndef RENDERER_ACCESS_HPP_INCLUDED
+#define RENDERER_ACCESS_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <VBN/Window.hpp>
+
+/*
+ * VBN's Renderer only exposes name-based drawing; the batched paths need
+ * the underlying SDL_Renderer, which SDL can resolve from the window ID.
+ */
+inline SDL_Renderer * getSDLRenderer(Window * window)
+{
+	if (!window)
+		return nullptr;
+
+	return SDL_GetRenderer(SDL_GetWindowFromID(window->getId()));
+}
+
+#endif // RENDERER_ACCESS_HPP_INCLUDED
@@ -0,0 +1,100 @@
+#include "SpriteBatch.hpp"
+#include "SpriteSheet.hpp"
+#include "CommandBuffer.hpp"
+#include <cmath>
+
+SpriteBatch::SpriteBatch(void) :
+	_sheet(nullptr)
+{}
+
+void SpriteBatch::begin(SpriteSheet const & sheet)
+{
+	_sheet = &sheet;
+	_vertices.clear();
+	_indices.clear();
+}
+
+void SpriteBatch::add(int const handle,
+	SDL_Rect const & destination,
+	SDL_Color const & color)
+{
+	if (!_sheet || handle < 0 || !_sheet->getWidth() || !_sheet->getHeight())
+		return;
+
+	SDL_Rect const & clip(_sheet->getClip(handle));
+	int const base(static_cast<int>(_vertices.size()));
+	float const scaleU(1.f / _sheet->getWidth()), scaleV(1.f / _sheet->getHeight());
+
+	float const u0(clip.x * scaleU), v0(clip.y * scaleV);
+	float const u1((clip.x + clip.w) * scaleU), v1((clip.y + clip.h) * scaleV);
+	float const x0(static_cast<float>(destination.x));
+	float const y0(static_cast<float>(destination.y));
+	float const x1(static_cast<float>(destination.x + destination.w));
+	float const y1(static_cast<float>(destination.y + destination.h));
+
+	_vertices.push_back({ { x0, y0 }, color, { u0, v0 } });
+	_vertices.push_back({ { x1, y0 }, color, { u1, v0 } });
+	_vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+	_vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+
+	_indices.insert(_indices.end(),
+		{ base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+void SpriteBatch::addRotated(int const handle,
+	float const centerX, float const centerY,
+	float const width, float const height,
+	double const angle,
+	SDL_Color const & color)
+{
+	if (!_sheet || handle < 0 || !_sheet->getWidth() || !_sheet->getHeight())
+		return;
+
+	SDL_Rect const & clip(_sheet->getClip(handle));
+	int const base(static_cast<int>(_vertices.size()));
+	float const scaleU(1.f / _sheet->getWidth()), scaleV(1.f / _sheet->getHeight());
+
+	float const u0(clip.x * scaleU), v0(clip.y * scaleV);
+	float const u1((clip.x + clip.w) * scaleU), v1((clip.y + clip.h) * scaleV);
+
+	/* Half extents along the rotated axes : y points down, hence clockwise */
+	double const radians(angle * (M_PI / 180.));
+	float const cosine(static_cast<float>(std::cos(radians)));
+	float const sine(static_cast<float>(std::sin(radians)));
+	float const alongX(width / 2.f * cosine), alongY(width / 2.f * sine);
+	float const acrossX(-height / 2.f * sine), acrossY(height / 2.f * cosine);
+
+	_vertices.push_back({ { centerX - alongX - acrossX, centerY - alongY - acrossY },
+		color, { u0, v0 } });
+	_vertices.push_back({ { centerX + alongX - acrossX, centerY + alongY - acrossY },
+		color, { u1, v0 } });
+	_vertices.push_back({ { centerX + alongX + acrossX, centerY + alongY + acrossY },
+		color, { u1, v1 } });
+	_vertices.push_back({ { centerX - alongX + acrossX, centerY - alongY + acrossY },
+		color, { u0, v1 } });
+
+	_indices.insert(_indices.end(),
+		{ base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+void SpriteBatch::reserve(std::size_t const sprites)
+{
+	_vertices.reserve(sprites * 4);
+	_indices.reserve(sprites * 6);
+}
+
+void SpriteBatch::submit(SDL_Renderer * renderer)
+{
+	if (renderer && _sheet && _sheet->getTexture() && !_indices.empty())
+		CommandBuffer::getInstance()->geometry(renderer, _sheet->getTexture(),
+			_vertices.data(), static_cast<int>(_vertices.size()),
+			_indices.data(), static_cast<int>(_indices.size()));
+
+	_vertices.clear();
+	_indices.clear();
+}
+
+std::size_t SpriteBatch::getSize(void) const
+{
+	return _indices.size() / 6;
+}
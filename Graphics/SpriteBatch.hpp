@@ -0,0 +1,39 @@
+#ifndef SPRITE_BATCH_HPP_INCLUDED
+#define SPRITE_BATCH_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+class SpriteSheet;
+
+/*
+ * Collects quads cut from a single sprite sheet and submits all of them
+ * with one SDL_RenderGeometry call. Buffers are kept between frames.
+ */
+class SpriteBatch
+{
+	private:
+		SpriteSheet const * _sheet;
+		std::vector<SDL_Vertex> _vertices;
+		std::vector<int> _indices;
+
+	public:
+		SpriteBatch(void);
+
+		void begin(SpriteSheet const & sheet);
+		void add(int const handle, SDL_Rect const & destination,
+			SDL_Color const & color = { 255, 255, 255, 255 });
+
+		/* Rotated <angle> degrees clockwise around its center, as copyEx */
+		void addRotated(int const handle,
+			float const centerX, float const centerY,
+			float const width, float const height,
+			double const angle,
+			SDL_Color const & color = { 255, 255, 255, 255 });
+		void reserve(std::size_t const sprites);
+		void submit(SDL_Renderer * renderer);
+
+		std::size_t getSize(void) const;
+};
+
+#endif // SPRITE_BATCH_HPP_INCLUDED
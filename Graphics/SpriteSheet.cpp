@@ -0,0 +1,116 @@
+#include "SpriteSheet.hpp"
+#include <sstream>
+
+SpriteSheet::SpriteSheet(SDL_Texture * texture) :
+	_texture(texture),
+	_width(0),
+	_height(0)
+{
+	if (_texture)
+		SDL_QueryTexture(_texture, nullptr, nullptr, &_width, &_height);
+}
+
+int SpriteSheet::addClip(std::string const & name, SDL_Rect const & clip)
+{
+	int const handle(static_cast<int>(_clips.size()));
+
+	_clips.push_back(clip);
+	_handles[name] = handle;
+
+	return handle;
+}
+
+/* Returns the number of clips added */
+int SpriteSheet::addClips(Blob const & clipFile)
+{
+	if (!clipFile.data)
+		return 0;
+
+	std::istringstream lines(std::string(clipFile.data.get(), clipFile.size));
+	std::string line;
+	int added(0);
+
+	while (std::getline(lines, line))
+	{
+		std::istringstream fields(line.substr(0, line.find('#')));
+		std::string name;
+		SDL_Rect clip;
+
+		if (!(fields >> name))
+			continue;
+
+		if (fields >> clip.x >> clip.y >> clip.w >> clip.h)
+		{
+			addClip(name, clip);
+			++added;
+		}
+		else
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+				"Invalid clip \"%s\"", line.c_str());
+	}
+
+	return added;
+}
+
+/* -1 for unknown names : the batch skips such sprites */
+int SpriteSheet::getHandle(std::string const & name) const
+{
+	auto const found(_handles.find(name));
+	return (found == _handles.end()) ? -1 : found->second;
+}
+
+SDL_Rect const & SpriteSheet::getClip(int const handle) const
+{
+	return _clips[handle];
+}
+
+SDL_Texture * SpriteSheet::getTexture(void) const
+{
+	return _texture;
+}
+
+int SpriteSheet::getWidth(void) const
+{
+	return _width;
+}
+
+int SpriteSheet::getHeight(void) const
+{
+	return _height;
+}
+
+std::unique_ptr<SpriteSheet> SpriteSheet::getResident(std::string const & texture,
+	std::string const & clips)
+{
+	std::shared_ptr<AssetLoader> loader(AssetLoader::getInstance());
+	SDL_Texture * const resident(loader->getTexture(texture));
+	std::unique_ptr<SpriteSheet> sheet;
+
+	if (!resident)
+		return sheet;
+
+	if (clips.empty())
+		sheet.reset(new SpriteSheet(resident));
+	else
+	{
+		Blob const clipFile(loader->getData(clips));
+		if (!clipFile.data)
+			return sheet;
+		sheet.reset(new SpriteSheet(resident));
+		sheet->addClips(clipFile);
+	}
+
+	return sheet;
+}
+
+std::unique_ptr<SpriteSheet> SpriteSheet::getAtlas(void)
+{
+	return getResident(SPRITE_ATLAS, SPRITE_ATLAS_CLIPS);
+}
+
+AssetLoader::Manifest SpriteSheet::getAtlasAssets(void)
+{
+	return {
+		{ AssetLoader::IMAGE, SPRITE_ATLAS, SPRITE_ATLAS_PATH },
+		{ AssetLoader::DATA, SPRITE_ATLAS_CLIPS, SPRITE_ATLAS_CLIPS_PATH } };
+}
@@ -0,0 +1,71 @@
+#ifndef SPRITE_SHEET_HPP_INCLUDED
+#define SPRITE_SHEET_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include "../System/AssetLoader.hpp"
+#include "../System/Blob.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Every sprite of the game, merged by Tools/AtlasPacker.cpp :
+ *   atlaspacker assets/textures/sprites \
+ *     sprite:TANK:assets/textures/tank.png \
+ *     sheet:assets/textures/xbox_px.png:assets/textures/xbox_px.clips
+ */
+#define SPRITE_ATLAS "sprites"
+#define SPRITE_ATLAS_PATH "assets/textures/sprites_0.png"
+#define SPRITE_ATLAS_CLIPS "sprites.clips"
+#define SPRITE_ATLAS_CLIPS_PATH "assets/textures/sprites_0.clips"
+
+/*
+ * One texture and its named clips. Names are resolved to integer handles
+ * once, at load time ; drawing only ever deals with handles.
+ *
+ * Sheets never own their texture : the AssetLoader's cache does, so views
+ * pushed again share what was loaded for the previous ones.
+ *
+ * Clips usually come from a clip file, one "<name> <x> <y> <w> <h>" per
+ * line, '#' starting a comment : either written by hand for a sheet or by
+ * Tools/AtlasPacker.cpp for an atlas page.
+ */
+class SpriteSheet
+{
+	private:
+		SDL_Texture * _texture;
+		int _width;
+		int _height;
+
+		std::vector<SDL_Rect> _clips;
+		std::unordered_map<std::string, int> _handles;
+
+	public:
+		SpriteSheet(SDL_Texture * texture);
+
+		SpriteSheet(SpriteSheet const &) = delete;
+		SpriteSheet & operator=(SpriteSheet const &) = delete;
+
+		int addClip(std::string const & name, SDL_Rect const & clip);
+		int addClips(Blob const & clipFile);
+		int getHandle(std::string const & name) const;
+		SDL_Rect const & getClip(int const handle) const;
+
+		SDL_Texture * getTexture(void) const;
+		int getWidth(void) const;
+		int getHeight(void) const;
+
+		/*
+		 * A sheet on AssetLoader textures & clip files, nullptr unless they
+		 * are resident. An empty clip file name asks for the texture only.
+		 */
+		static std::unique_ptr<SpriteSheet> getResident(std::string const & texture,
+			std::string const & clips);
+
+		/* The resident sprite atlas, or nullptr if it was not built */
+		static std::unique_ptr<SpriteSheet> getAtlas(void);
+		static AssetLoader::Manifest getAtlasAssets(void);
+};
+
+#endif // SPRITE_SHEET_HPP_INCLUDED
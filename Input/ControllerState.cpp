@@ -0,0 +1,38 @@
+#include "ControllerState.hpp"
+
+static_assert(SDL_CONTROLLER_BUTTON_MAX <= 32,
+	"ControllerState::buttons cannot hold every controller button");
+
+ControllerState::ControllerState(void) :
+	connected(false),
+	axes{},
+	buttons(0)
+{}
+
+void ControllerState::sample(SDL_GameController * controller)
+{
+	connected = (controller != nullptr);
+	buttons = 0;
+
+	for (int axis(0); axis < SDL_CONTROLLER_AXIS_MAX; ++axis)
+		axes[axis] = connected ? SDL_GameControllerGetAxis(controller,
+			static_cast<SDL_GameControllerAxis>(axis)) : 0;
+
+	if (!connected)
+		return;
+
+	for (int button(0); button < SDL_CONTROLLER_BUTTON_MAX; ++button)
+		if (SDL_GameControllerGetButton(controller,
+			static_cast<SDL_GameControllerButton>(button)))
+			buttons |= (1u << button);
+}
+
+Sint16 ControllerState::getAxis(SDL_GameControllerAxis const axis) const
+{
+	return axes[axis];
+}
+
+bool ControllerState::getButton(SDL_GameControllerButton const button) const
+{
+	return (buttons >> button) & 1u;
+}
@@ -0,0 +1,24 @@
+#ifndef CONTROLLER_STATE_HPP_INCLUDED
+#define CONTROLLER_STATE_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+
+/*
+ * Snapshot of one game controller : every axis and a button bitmask, indexed
+ * by the SDL enumerations. Plain data, so it can be recorded as-is.
+ */
+class ControllerState
+{
+	public:
+		bool connected;
+		Sint16 axes[SDL_CONTROLLER_AXIS_MAX];
+		Uint32 buttons;
+
+		ControllerState(void);
+
+		void sample(SDL_GameController * controller);
+		Sint16 getAxis(SDL_GameControllerAxis const axis) const;
+		bool getButton(SDL_GameControllerButton const button) const;
+};
+
+#endif // CONTROLLER_STATE_HPP_INCLUDED
@@ -0,0 +1,71 @@
+#include "EventCoalescer.hpp"
+
+bool EventCoalescer::isSameSource(SDL_Event const & first,
+	SDL_Event const & second)
+{
+	if (first.type != second.type)
+		return false;
+
+	switch (first.type)
+	{
+		case SDL_MOUSEMOTION:
+			return first.motion.windowID == second.motion.windowID
+				&& first.motion.which == second.motion.which;
+
+		case SDL_CONTROLLERAXISMOTION:
+			return first.caxis.which == second.caxis.which
+				&& first.caxis.axis == second.caxis.axis;
+
+		case SDL_JOYAXISMOTION:
+			return first.jaxis.which == second.jaxis.which
+				&& first.jaxis.axis == second.jaxis.axis;
+
+		case SDL_WINDOWEVENT:
+			return first.window.event == SDL_WINDOWEVENT_SIZE_CHANGED
+				&& second.window.event == SDL_WINDOWEVENT_SIZE_CHANGED
+				&& first.window.windowID == second.window.windowID;
+
+		default:
+			return false;
+	}
+}
+
+void EventCoalescer::merge(SDL_Event & into, SDL_Event const & event)
+{
+	if (event.type == SDL_MOUSEMOTION)
+	{
+		Sint32 const xrel(into.motion.xrel + event.motion.xrel);
+		Sint32 const yrel(into.motion.yrel + event.motion.yrel);
+
+		into = event;
+		into.motion.xrel = xrel;
+		into.motion.yrel = yrel;
+		return;
+	}
+
+	into = event;
+}
+
+std::size_t EventCoalescer::coalesce(SDL_Event * events, std::size_t const count)
+{
+	std::size_t kept(0);
+
+	for (std::size_t index(0); index < count; ++index)
+	{
+		std::size_t source(0);
+
+		while (source < kept && !isSameSource(events[source], events[index]))
+			++source;
+
+		if (source < kept)
+			merge(events[source], events[index]);
+		else
+		{
+			if (kept != index)
+				events[kept] = events[index];
+			++kept;
+		}
+	}
+
+	return kept;
+}
@@ -0,0 +1,29 @@
+#ifndef EVENT_COALESCER_HPP_INCLUDED
+#define EVENT_COALESCER_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+/*
+ * Merges the events of a frame's motion batch (see GameContext::isBatched)
+ * that come from the same source, keeping the first one's place :
+ * - mouse motion, per window & mouse : relative motion summed, the rest
+ *   (position, button state, timestamp) from the latest
+ * - controller & joystick axis motion, per device & axis : latest value
+ * - window size changes, per window : latest size
+ *
+ * Sources are few, so merged events are looked up linearly.
+ */
+class EventCoalescer
+{
+	private:
+		static bool isSameSource(SDL_Event const & first,
+			SDL_Event const & second);
+		static void merge(SDL_Event & into, SDL_Event const & event);
+
+	public:
+		/* Compacts events in place, returns how many are left */
+		static std::size_t coalesce(SDL_Event * events, std::size_t const count);
+};
+
+#endif // EVENT_COALESCER_HPP_INCLUDED
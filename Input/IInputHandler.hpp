@@ -0,0 +1,52 @@
+#ifndef I_INPUT_HANDLER_HPP_INCLUDED
+#define I_INPUT_HANDLER_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+class EngineUpdate;
+class GameContext;
+class Platform;
+class Window;
+
+/*
+ * What every handler of a dispatch may need, resolved once by the owning
+ * GameContext : borrowed, valid for the duration of the call only.
+ */
+struct InputContext
+{
+	EngineUpdate & engineUpdate;
+	Platform & platform;
+	Window * mainWindow;
+
+	/* The dispatching context, null on VBN's IEventHandler path */
+	GameContext * gameContext;
+};
+
+/*
+ * Event handling along the Global::EventHandler chain. Unlike VBN's
+ * IEventHandler, nothing is shared_ptr-copied at each hop and no window is
+ * looked up by name per event.
+ *
+ * High-frequency events (motion, axes) queued during a frame come in as one
+ * batch : handlers with per-batch work override handleInputBatch, others
+ * get its default, one handleInput call per event.
+ */
+class IInputHandler
+{
+	public:
+		virtual ~IInputHandler(void) {}
+
+		virtual void handleInput(SDL_Event const & event,
+			InputContext const & context) = 0;
+
+		virtual void handleInputBatch(SDL_Event const * events,
+			std::size_t const count,
+			InputContext const & context)
+		{
+			for (std::size_t index(0); index < count; ++index)
+				handleInput(events[index], context);
+		}
+};
+
+#endif // I_INPUT_HANDLER_HPP_INCLUDED
@@ -0,0 +1,280 @@
+#include "InputRecorder.hpp"
+#include <VBN/Logging.hpp>
+#include <algorithm>
+#include <cstring>
+
+InputRecorder::InputRecorder(void) :
+	_mode(LIVE),
+	_origin(0),
+	_ticks(0)
+{}
+
+std::shared_ptr<InputRecorder> InputRecorder::getInstance(void)
+{
+	static std::shared_ptr<InputRecorder> instance(new InputRecorder);
+	return instance;
+}
+
+bool InputRecorder::startRecording(std::string const & path)
+{
+	Uint16 const version(INPUT_RECORDING_VERSION), reserved(0);
+
+	stop();
+	_output.open(path, std::ios::binary | std::ios::trunc);
+	if (!_output)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_INPUT,
+			"Cannot open input recording \"%s\"", path.c_str());
+		return false;
+	}
+
+	_output.write(INPUT_RECORDING_MAGIC, 4);
+	_output.write(reinterpret_cast<char const *>(&version), sizeof(version));
+	_output.write(reinterpret_cast<char const *>(&reserved), sizeof(reserved));
+
+	_mode = RECORD;
+	_origin = SDL_GetTicks();
+	_ticks = 0;
+	INFO(SDL_LOG_CATEGORY_INPUT, "Recording input to \"%s\"", path.c_str());
+
+	return true;
+}
+
+bool InputRecorder::startReplay(std::string const & path)
+{
+	char magic[4] = { 0 };
+	Uint16 version(0), reserved(0);
+
+	stop();
+	_input.open(path, std::ios::binary);
+	_input.read(magic, sizeof(magic));
+	_input.read(reinterpret_cast<char *>(&version), sizeof(version));
+	_input.read(reinterpret_cast<char *>(&reserved), sizeof(reserved));
+
+	if (!_input || std::memcmp(magic, INPUT_RECORDING_MAGIC, 4)
+		|| version != INPUT_RECORDING_VERSION)
+	{
+		if (_input && !std::memcmp(magic, INPUT_RECORDING_MAGIC, 4)
+			&& version < INPUT_RECORDING_VERSION)
+			SDL_LogError(SDL_LOG_CATEGORY_INPUT,
+				"\"%s\" is a version %d input recording, from before player "
+				"slots : record it again", path.c_str(), version);
+		else
+			SDL_LogError(SDL_LOG_CATEGORY_INPUT,
+				"\"%s\" is not a version %d input recording",
+				path.c_str(), INPUT_RECORDING_VERSION);
+		_input.close();
+		return false;
+	}
+
+	_mode = REPLAY;
+	_origin = SDL_GetTicks();
+	_ticks = 0;
+	INFO(SDL_LOG_CATEGORY_INPUT, "Replaying input from \"%s\"", path.c_str());
+
+	return true;
+}
+
+void InputRecorder::stop(void)
+{
+	if (_output.is_open())
+		_output.close();
+	if (_input.is_open())
+		_input.close();
+
+	_polls.clear();
+	_mode = LIVE;
+}
+
+InputRecorder::Mode InputRecorder::getMode(void) const
+{
+	return _mode;
+}
+
+/* Only user input is recorded : device, window & quit events stay live */
+Uint8 InputRecorder::getRecordedSize(Uint32 const type)
+{
+	switch (type)
+	{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			return sizeof(SDL_KeyboardEvent);
+		case SDL_TEXTINPUT:
+			return sizeof(SDL_TextInputEvent);
+		case SDL_MOUSEMOTION:
+			return sizeof(SDL_MouseMotionEvent);
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			return sizeof(SDL_MouseButtonEvent);
+		case SDL_MOUSEWHEEL:
+			return sizeof(SDL_MouseWheelEvent);
+		case SDL_JOYAXISMOTION:
+			return sizeof(SDL_JoyAxisEvent);
+		case SDL_JOYHATMOTION:
+			return sizeof(SDL_JoyHatEvent);
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			return sizeof(SDL_JoyButtonEvent);
+		case SDL_CONTROLLERAXISMOTION:
+			return sizeof(SDL_ControllerAxisEvent);
+		case SDL_CONTROLLERBUTTONDOWN:
+		case SDL_CONTROLLERBUTTONUP:
+			return sizeof(SDL_ControllerButtonEvent);
+		default:
+			return 0;
+	}
+}
+
+void InputRecorder::writeHeader(Uint8 const kind)
+{
+	Uint32 const timestamp(SDL_GetTicks() - _origin);
+
+	_output.put(static_cast<char>(kind));
+	_output.write(reinterpret_cast<char const *>(&timestamp), sizeof(timestamp));
+}
+
+bool InputRecorder::acceptLiveEvent(SDL_Event const & event)
+{
+	Uint8 const size(getRecordedSize(event.type));
+
+	switch (_mode)
+	{
+		case RECORD:
+			if (size)
+			{
+				writeHeader(EVENT);
+				_output.put(static_cast<char>(size));
+				_output.write(reinterpret_cast<char const *>(&event), size);
+			}
+		return true;
+
+		/* Recorded input replaces live input */
+		case REPLAY:
+		return !size;
+
+		default:
+		return true;
+	}
+}
+
+bool InputRecorder::readPoll(Uint8 & player, ControllerState & state)
+{
+	player = static_cast<Uint8>(_input.get());
+	state.connected = (_input.get() != 0);
+	_input.read(reinterpret_cast<char *>(state.axes), sizeof(state.axes));
+	_input.read(reinterpret_cast<char *>(&state.buttons), sizeof(state.buttons));
+
+	return static_cast<bool>(_input);
+}
+
+Uint32 InputRecorder::beginTick(Uint32 const gameTicks,
+	std::vector<SDL_Event> & replayedEvents)
+{
+	replayedEvents.clear();
+
+	if (_mode == RECORD)
+	{
+		writeHeader(TICK);
+		_output.write(reinterpret_cast<char const *>(&gameTicks), sizeof(gameTicks));
+		++_ticks;
+		return gameTicks;
+	}
+
+	if (_mode != REPLAY)
+		return gameTicks;
+
+	/* Events up to the next tick, that tick, then the polls made during it */
+	int kind(0);
+	Uint32 timestamp(0);
+
+	_polls.clear();
+	while ((kind = _input.get()) != std::char_traits<char>::eof())
+	{
+		_input.read(reinterpret_cast<char *>(&timestamp), sizeof(timestamp));
+
+		if (kind == EVENT)
+		{
+			SDL_Event event{};
+			std::size_t const size(static_cast<Uint8>(_input.get()));
+			std::size_t const kept(std::min(size, sizeof(SDL_Event)));
+
+			_input.read(reinterpret_cast<char *>(&event), kept);
+			_input.ignore(size - kept);
+			replayedEvents.push_back(event);
+		}
+		else if (kind == TICK)
+		{
+			Uint32 ticks(0);
+			Uint8 player(0);
+			ControllerState state;
+
+			_input.read(reinterpret_cast<char *>(&ticks), sizeof(ticks));
+			while (_input.peek() == POLL)
+			{
+				_input.get();
+				_input.read(reinterpret_cast<char *>(&timestamp), sizeof(timestamp));
+				if (readPoll(player, state))
+					_polls.emplace_back(player, state);
+			}
+
+			if (!_input && !_input.eof())
+				break;
+
+			++_ticks;
+			return ticks;
+		}
+		else if (kind == POLL)
+		{
+			Uint8 player(0);
+			ControllerState state;
+			readPoll(player, state);
+		}
+		else
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_INPUT,
+				"Corrupt input recording record (kind %d)", kind);
+			break;
+		}
+	}
+
+	INFO(SDL_LOG_CATEGORY_INPUT,
+		"Replay finished after %llu ticks",
+		static_cast<unsigned long long>(_ticks));
+	stop();
+
+	return gameTicks;
+}
+
+bool InputRecorder::pollController(SDL_GameController * controller,
+	int const player,
+	ControllerState & state)
+{
+	if (_mode == REPLAY)
+	{
+		for (auto it(_polls.begin()); it != _polls.end(); ++it)
+		{
+			if (it->first != player)
+				continue;
+
+			state = it->second;
+			_polls.erase(it);
+			return state.connected;
+		}
+
+		state = ControllerState();
+		return false;
+	}
+
+	state.sample(controller);
+
+	if (_mode == RECORD)
+	{
+		writeHeader(POLL);
+		_output.put(static_cast<char>(player));
+		_output.put(static_cast<char>(state.connected));
+		_output.write(reinterpret_cast<char const *>(state.axes), sizeof(state.axes));
+		_output.write(reinterpret_cast<char const *>(&state.buttons), sizeof(state.buttons));
+	}
+
+	return state.connected;
+}
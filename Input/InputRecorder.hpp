@@ -0,0 +1,81 @@
+#ifndef INPUT_RECORDER_HPP_INCLUDED
+#define INPUT_RECORDER_HPP_INCLUDED
+
+#include "ControllerState.hpp"
+#include <SDL2/SDL.h>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define INPUT_RECORDING_MAGIC "OPIR"
+/* Version 1 keyed polls by device index, which is not a player slot */
+#define INPUT_RECORDING_VERSION 2
+
+/*
+ * Records dispatched input events and the controller polls made during
+ * each tick (see InputService) to a compact binary file, or plays such a
+ * file back with no hardware attached.
+ *
+ * File layout : 4-byte magic, Uint16 version, Uint16 reserved, then records
+ * made of a Uint8 kind and a Uint32 timestamp (ms since recording start),
+ * followed by :
+ * - EVENT : Uint8 size, then the first <size> bytes of the SDL_Event
+ * - TICK : Uint32 game ticks handed to the elapsing context
+ * - POLL : Uint8 player, Uint8 connected, Sint16 axes[], Uint32 buttons
+ *
+ * Events are replayed at tick granularity, before the tick they preceded,
+ * so a replay is deterministic whatever the replaying machine's frame rate.
+ */
+class InputRecorder
+{
+	public:
+		enum Mode
+		{
+			LIVE,
+			RECORD,
+			REPLAY
+		};
+
+		enum RecordKind
+		{
+			EVENT = 1,
+			TICK = 2,
+			POLL = 3
+		};
+
+	private:
+		Mode _mode;
+		std::ofstream _output;
+		std::ifstream _input;
+		Uint32 _origin;
+		Uint64 _ticks;
+
+		std::deque<std::pair<Uint8, ControllerState>> _polls;
+
+		InputRecorder(void);
+
+		void writeHeader(Uint8 const kind);
+		bool readPoll(Uint8 & player, ControllerState & state);
+
+		static Uint8 getRecordedSize(Uint32 const type);
+
+	public:
+		static std::shared_ptr<InputRecorder> getInstance(void);
+
+		bool startRecording(std::string const & path);
+		bool startReplay(std::string const & path);
+		void stop(void);
+		Mode getMode(void) const;
+
+		bool acceptLiveEvent(SDL_Event const & event);
+		Uint32 beginTick(Uint32 const gameTicks,
+			std::vector<SDL_Event> & replayedEvents);
+		bool pollController(SDL_GameController * controller,
+			int const player,
+			ControllerState & state);
+};
+
+#endif // INPUT_RECORDER_HPP_INCLUDED
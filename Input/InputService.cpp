@@ -0,0 +1,161 @@
+#include "InputService.hpp"
+#include "InputRecorder.hpp"
+#include <VBN/Logging.hpp>
+#include <cstring>
+
+InputService::InputService(void) :
+	_snapshot{},
+	_sampled(false),
+	_slots{},
+	_source()
+{
+	for (Slot & slot : _slots)
+		slot.instance = -1;
+}
+
+std::shared_ptr<InputService> InputService::getInstance(void)
+{
+	static std::shared_ptr<InputService> instance(new InputService);
+	return instance;
+}
+
+/*
+ * Live, only connected players are polled, under a single acquisition of
+ * SDL's joystick lock. Replayed, every recorded player is.
+ */
+void InputService::sampleControllers(InputSnapshot & snapshot)
+{
+	std::shared_ptr<InputRecorder> recorder(InputRecorder::getInstance());
+	bool const live(recorder->getMode() != InputRecorder::REPLAY);
+	ControllerState state;
+
+	snapshot.connected = 0;
+
+	if (live)
+		SDL_LockJoysticks();
+
+	for (int player(0); player < INPUT_MAX_PLAYERS; ++player)
+	{
+		if ((live && !_slots[player].controller)
+			|| !recorder->pollController(_slots[player].controller, player, state))
+		{
+			std::memset(snapshot.axes[player], 0, sizeof(snapshot.axes[player]));
+			snapshot.buttons[player] = 0;
+			continue;
+		}
+
+		snapshot.connected |= 1u << player;
+		std::memcpy(snapshot.axes[player], state.axes, sizeof(state.axes));
+		snapshot.buttons[player] = state.buttons;
+	}
+
+	if (live)
+		SDL_UnlockJoysticks();
+}
+
+void InputService::update(void)
+{
+	++_snapshot.frame;
+	_sampled = false;
+}
+
+InputSnapshot const & InputService::getSnapshot(void)
+{
+	if (_sampled)
+		return _snapshot;
+	_sampled = true;
+
+	if (_source)
+		_source(_snapshot);
+	else
+		sampleControllers(_snapshot);
+
+	return _snapshot;
+}
+
+void InputService::setSource(Source source)
+{
+	_source = source;
+}
+
+int InputService::connectController(int const deviceIndex)
+{
+	SDL_JoystickID const instance(SDL_JoystickGetDeviceInstanceID(deviceIndex));
+	SDL_JoystickGUID const guid(SDL_JoystickGetDeviceGUID(deviceIndex));
+	int player(getPlayer(instance));
+
+	if (player >= 0)
+		return player;
+
+	/* Its own reserved slot first, then a fresh one, then a stale one */
+	for (int pass(0); pass < 3 && player < 0; ++pass)
+		for (int slot(0); slot < INPUT_MAX_PLAYERS && player < 0; ++slot)
+		{
+			Slot const & candidate(_slots[slot]);
+
+			if (candidate.controller)
+				continue;
+			if ((pass == 0 && candidate.reserved
+					&& !std::memcmp(&candidate.guid, &guid, sizeof(guid)))
+				|| (pass == 1 && !candidate.reserved)
+				|| pass == 2)
+				player = slot;
+		}
+
+	if (player < 0)
+	{
+		SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
+			"No player slot left for instance @%d", instance);
+		return -1;
+	}
+
+	Slot & slot(_slots[player]);
+	slot.instance = instance;
+	slot.guid = guid;
+	slot.controller = SDL_GameControllerFromInstanceID(instance);
+	slot.reserved = true;
+
+	INFO(SDL_LOG_CATEGORY_INPUT,
+		"Instance @%d is player %d", instance, player + 1);
+
+	return player;
+}
+
+/* The slot keeps its reservation */
+int InputService::disconnectController(SDL_JoystickID const instance)
+{
+	int const player(getPlayer(instance));
+
+	if (player < 0)
+		return -1;
+
+	_slots[player].instance = -1;
+	_slots[player].controller = nullptr;
+
+	INFO(SDL_LOG_CATEGORY_INPUT, "Player %d disconnected", player + 1);
+
+	return player;
+}
+
+int InputService::getPlayer(SDL_JoystickID const instance) const
+{
+	if (instance < 0)
+		return -1;
+
+	for (int player(0); player < INPUT_MAX_PLAYERS; ++player)
+		if (_slots[player].instance == instance)
+			return player;
+
+	return -1;
+}
+
+int InputService::getConnectedPlayers(void) const
+{
+	int players(0);
+
+	for (Slot const & slot : _slots)
+		if (slot.controller)
+			++players;
+
+	return players;
+}
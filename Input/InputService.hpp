@@ -0,0 +1,105 @@
+#ifndef INPUT_SERVICE_HPP_INCLUDED
+#define INPUT_SERVICE_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <functional>
+#include <memory>
+
+/* Local players, each holding at most one controller */
+#define INPUT_MAX_PLAYERS 8
+
+static_assert(SDL_CONTROLLER_BUTTON_MAX <= 32,
+	"Player buttons are held on 32 bits");
+
+/*
+ * Every player's controller as of the start of the current frame's elapse,
+ * one array per field : reading one axis of every player walks contiguous
+ * memory, and the whole snapshot is a single flat copy.
+ */
+struct InputSnapshot
+{
+	Uint64 frame;
+	Uint32 connected;
+	Sint16 axes[INPUT_MAX_PLAYERS][SDL_CONTROLLER_AXIS_MAX];
+	Uint32 buttons[INPUT_MAX_PLAYERS];
+
+	/* Out of range players read as disconnected */
+	bool isConnected(int const player) const
+	{
+		return player >= 0 && player < INPUT_MAX_PLAYERS
+			&& (connected & (1u << player));
+	}
+
+	Sint16 getAxis(int const player, SDL_GameControllerAxis const axis) const
+	{
+		return isConnected(player) ? axes[player][axis] : 0;
+	}
+
+	bool getButton(int const player, SDL_GameControllerButton const button) const
+	{
+		return isConnected(player) && (buttons[player] & (1u << button));
+	}
+};
+
+/*
+ * Samples input at most once per frame into a snapshot that models read
+ * instead of polling SDL, however many steps they take in the frame.
+ * Sampling is lazy : update (called by GameContext::elapse) only starts a
+ * new frame, and the first getSnapshot of that frame polls. Frames of
+ * contexts that never read controllers (menus, pause, loading) poll
+ * nothing, and neither record nor replay polls.
+ *
+ * Controllers are given player slots as they connect. A slot stays reserved
+ * to its controller (by GUID) after a disconnection : the same controller
+ * plugged back in gets its player back, unless every other slot was taken
+ * meanwhile.
+ *
+ * The default source goes through InputRecorder, so recordings & replays
+ * see one poll per player per tick. Anything else (scripted input, tests)
+ * can take its place with setSource.
+ */
+class InputService
+{
+	public:
+		typedef std::function<void(InputSnapshot & snapshot)> Source;
+
+	private:
+		struct Slot
+		{
+			SDL_JoystickID instance;
+			SDL_JoystickGUID guid;
+			SDL_GameController * controller;
+			bool reserved;
+		};
+
+		InputSnapshot _snapshot;
+		bool _sampled;
+		std::array<Slot, INPUT_MAX_PLAYERS> _slots;
+		Source _source;
+
+		InputService(void);
+
+		void sampleControllers(InputSnapshot & snapshot);
+
+	public:
+		static std::shared_ptr<InputService> getInstance(void);
+
+		void update(void);
+
+		/* Render thread only : the first call in a frame samples */
+		InputSnapshot const & getSnapshot(void);
+
+		/* An empty source restores the default one */
+		void setSource(Source source);
+
+		/* Hotplug : the controller must already be open. Return the player */
+		int connectController(int const deviceIndex);
+		int disconnectController(SDL_JoystickID const instance);
+
+		/* Player of a controller event's "which", -1 if it has none */
+		int getPlayer(SDL_JoystickID const instance) const;
+		int getConnectedPlayers(void) const;
+};
+
+#endif // INPUT_SERVICE_HPP_INCLUDED
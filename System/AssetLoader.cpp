@@ -0,0 +1,538 @@
+#include "AssetLoader.hpp"
+#include "../Graphics/GlyphAtlas.hpp"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+AssetLoader::AssetLoader(void) :
+	_stopping(false),
+	_textureGeneration(0)
+{}
+
+AssetLoader::~AssetLoader(void)
+{
+	stopWorkers();
+}
+
+std::shared_ptr<AssetLoader> AssetLoader::getInstance(void)
+{
+	static std::shared_ptr<AssetLoader> instance(new AssetLoader);
+	return instance;
+}
+
+/* Started on the first request : one core is left to the render thread */
+void AssetLoader::startWorkers(void)
+{
+	if (!_workers.empty())
+		return;
+
+	int const workers(std::max(1,
+		std::min(SDL_GetCPUCount() - 1, ASSET_LOADER_MAX_WORKERS)));
+
+	_stopping = false;
+	for (int worker(0); worker < workers; ++worker)
+		_workers.emplace_back(&AssetLoader::work, this);
+}
+
+void AssetLoader::stopWorkers(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for (std::thread & worker : _workers)
+		worker.join();
+	_workers.clear();
+}
+
+void AssetLoader::work(void)
+{
+	for (;;)
+	{
+		Asset asset;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this]{ return _stopping || !_queued.empty(); });
+			if (_stopping)
+				return;
+
+			asset = _queued.front();
+			_queued.pop_front();
+		}
+
+		Decoded decoded(decode(asset));
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_decoded.push_back(decoded);
+	}
+}
+
+Blob AssetLoader::readFile(std::string const & path)
+{
+	SDL_RWops * file(SDL_RWFromFile(path.c_str(), "rb"));
+	if (!file)
+		return { nullptr, 0 };
+
+	Sint64 const size(SDL_RWsize(file));
+	std::shared_ptr<std::vector<char>> bytes;
+
+	if (size > 0)
+	{
+		bytes = std::make_shared<std::vector<char>>(static_cast<std::size_t>(size));
+		if (SDL_RWread(file, bytes->data(), bytes->size(), 1) != 1)
+			bytes.reset();
+	}
+	SDL_RWclose(file);
+
+	if (!bytes)
+		return { nullptr, 0 };
+	return { std::shared_ptr<char const>(bytes, bytes->data()), bytes->size() };
+}
+
+/* Mixer decoders are brought up on first use, before any worker needs one */
+void AssetLoader::initDecoder(std::string const & path)
+{
+	static std::pair<char const *, int> const decoders[] = {
+		{ ".flac", MIX_INIT_FLAC }, { ".mid", MIX_INIT_MID },
+		{ ".mod", MIX_INIT_MOD }, { ".xm", MIX_INIT_MOD }, { ".it", MIX_INIT_MOD },
+		{ ".s3m", MIX_INIT_MOD }, { ".mp3", MIX_INIT_MP3 },
+		{ ".ogg", MIX_INIT_OGG }, { ".opus", MIX_INIT_OPUS } };
+	std::size_t const dot(path.rfind('.'));
+	std::string extension(dot == std::string::npos ? "" : path.substr(dot));
+
+	std::transform(extension.begin(), extension.end(), extension.begin(),
+		[](unsigned char const c) { return static_cast<char>(std::tolower(c)); });
+	for (auto const & decoder : decoders)
+		if (extension == decoder.first && !(Mix_Init(0) & decoder.second))
+			Mix_Init(decoder.second);
+}
+
+/* Worker side : nothing here may touch the renderer */
+AssetLoader::Decoded AssetLoader::decode(Asset const & asset)
+{
+	Decoded decoded{ asset, nullptr, nullptr, 0, { nullptr, 0 }, nullptr, {} };
+
+	switch (asset.kind)
+	{
+		case IMAGE:
+			decoded.surface = IMG_Load(asset.path.c_str());
+		break;
+
+		/* SDL_mixer is not thread-safe : the chunk is made in finish() */
+		case SAMPLE:
+			SDL_LoadWAV(asset.path.c_str(), &decoded.spec,
+				&decoded.samples, &decoded.length);
+		break;
+
+		/* Fonts & musics are opened from memory on the render thread */
+		case FONT:
+		case MUSIC:
+		case DATA:
+			decoded.bytes = readFile(asset.path);
+		break;
+	}
+
+	if (!decoded.surface && !decoded.samples && !decoded.bytes.data)
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+			"Cannot load asset \"%s\" from \"%s\" : %s",
+			asset.name.c_str(), asset.path.c_str(), SDL_GetError());
+
+	return decoded;
+}
+
+void AssetLoader::release(Decoded & decoded)
+{
+	if (decoded.surface)
+		SDL_FreeSurface(decoded.surface);
+	if (decoded.samples)
+		SDL_FreeWAV(decoded.samples);
+	decoded.surface = nullptr;
+	decoded.samples = nullptr;
+}
+
+void AssetLoader::setPack(std::shared_ptr<AssetPack> pack)
+{
+	_pack = pack;
+}
+
+/* Packed data is only used when it is exactly what the asset needs */
+bool AssetLoader::findPacked(Asset const & asset, Decoded & decoded)
+{
+	AssetPack::Entry const * entry(_pack ? _pack->find(asset.name) : nullptr);
+	int frequency(0), channels(0);
+	Uint16 format(0);
+
+	if (!entry)
+		return false;
+
+	switch (asset.kind)
+	{
+		case IMAGE:
+			if (entry->kind != AssetPack::PIXELS)
+				return false;
+		break;
+
+		/* Samples play as they are : the mixer must use the packed format */
+		case SAMPLE:
+			if (entry->kind != AssetPack::PCM
+				|| !Mix_QuerySpec(&frequency, &format, &channels)
+				|| entry->width != static_cast<Uint32>(frequency)
+				|| entry->format != format
+				|| entry->height != static_cast<Uint32>(channels))
+				return false;
+		break;
+
+		case FONT:
+		case MUSIC:
+		case DATA:
+			if (entry->kind != AssetPack::BLOB)
+				return false;
+			decoded.bytes = _pack->getBlob(*entry);
+		break;
+	}
+
+	decoded.packed = entry;
+	return true;
+}
+
+void AssetLoader::request(Manifest const & manifest)
+{
+	bool queued(false);
+
+	for (Asset const & asset : manifest)
+	{
+		if (_states.count(asset.name))
+			continue;
+
+		_states[asset.name] = QUEUED;
+		if (asset.kind == MUSIC)
+			initDecoder(asset.path);
+		Decoded decoded{ asset, nullptr, nullptr, 0, { nullptr, 0 }, nullptr, {} };
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (findPacked(asset, decoded))
+			_decoded.push_back(decoded);
+		else
+		{
+			_queued.push_back(asset);
+			queued = true;
+		}
+	}
+
+	if (queued)
+	{
+		startWorkers();
+		_wake.notify_all();
+	}
+}
+
+/* Render thread side : WAV PCM in the mixer's format, in a chunk owning it */
+Mix_Chunk * AssetLoader::createChunk(Decoded const & decoded)
+{
+	int frequency(0), channels(0);
+	Uint16 format(0);
+	SDL_AudioCVT conversion;
+
+	if (!Mix_QuerySpec(&frequency, &format, &channels)
+		|| SDL_BuildAudioCVT(&conversion, decoded.spec.format,
+			decoded.spec.channels, decoded.spec.freq,
+			format, static_cast<Uint8>(channels), frequency) < 0)
+		return nullptr;
+
+	conversion.len = static_cast<int>(decoded.length);
+	conversion.buf = static_cast<Uint8 *>(
+		SDL_malloc(decoded.length * conversion.len_mult));
+	if (!conversion.buf)
+		return nullptr;
+	std::memcpy(conversion.buf, decoded.samples, decoded.length);
+
+	Mix_Chunk * chunk(nullptr);
+	if (!conversion.needed || SDL_ConvertAudio(&conversion) == 0)
+		chunk = Mix_QuickLoad_RAW(conversion.buf, static_cast<Uint32>(
+			conversion.needed ? conversion.len_cvt : conversion.len));
+	if (!chunk)
+	{
+		SDL_free(conversion.buf);
+		return nullptr;
+	}
+
+	/* Mix_FreeChunk then frees the buffer too */
+	chunk->allocated = 1;
+	return chunk;
+}
+
+/* Render thread side : turns a decoded asset into a resident one */
+bool AssetLoader::finish(SDL_Renderer * renderer, Decoded & decoded)
+{
+	std::string const & name(decoded.asset.name);
+	AssetPack::Entry const * packed(decoded.packed);
+
+	switch (decoded.asset.kind)
+	{
+		case IMAGE:
+		{
+			SDL_Texture * texture(nullptr);
+
+			/* Packed pixels are already in a texture format : upload as is */
+			if (packed)
+			{
+				texture = SDL_CreateTexture(renderer, packed->format,
+					SDL_TEXTUREACCESS_STATIC, packed->width, packed->height);
+				if (texture && SDL_UpdateTexture(texture, nullptr,
+					_pack->getData(*packed), packed->pitch) != 0)
+				{
+					SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+						"Cannot upload packed image \"%s\" : %s",
+						name.c_str(), SDL_GetError());
+					SDL_DestroyTexture(texture);
+					texture = nullptr;
+				}
+				if (texture)
+					SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+			}
+			else if (decoded.surface)
+			{
+				texture = SDL_CreateTextureFromSurface(renderer, decoded.surface);
+				SDL_FreeSurface(decoded.surface);
+				decoded.surface = nullptr;
+			}
+
+			if (!texture)
+				return false;
+
+			_textures[name] = texture;
+			_images[name] = decoded.asset;
+			return true;
+		}
+
+		case FONT:
+			if (!decoded.bytes.data)
+				return false;
+
+			TextCache::getInstance()->addFontData(name, decoded.bytes);
+			return true;
+
+		case SAMPLE:
+		{
+			Mix_Chunk * chunk(nullptr);
+
+			/* The chunk plays straight from the mapping */
+			if (packed)
+				chunk = Mix_QuickLoad_RAW(reinterpret_cast<Uint8 *>(
+					const_cast<char *>(_pack->getData(*packed))),
+					static_cast<Uint32>(packed->size));
+			else if (decoded.samples)
+			{
+				chunk = createChunk(decoded);
+				SDL_FreeWAV(decoded.samples);
+				decoded.samples = nullptr;
+			}
+			if (!chunk)
+				return false;
+
+			_samples[name] = chunk;
+			return true;
+		}
+
+		case MUSIC:
+		{
+			if (!decoded.bytes.data)
+				return false;
+
+			/* Music is streamed : its bytes live as long as the stream */
+			Mix_Music * music(Mix_LoadMUS_RW(SDL_RWFromConstMem(
+				decoded.bytes.data.get(), static_cast<int>(decoded.bytes.size)), 1));
+			if (!music)
+				return false;
+
+			_musics[name] = { music, decoded.bytes };
+			return true;
+		}
+
+		case DATA:
+			if (!decoded.bytes.data)
+				return false;
+
+			_data[name] = decoded.bytes;
+			return true;
+	}
+
+	return false;
+}
+
+void AssetLoader::update(SDL_Renderer * renderer)
+{
+	if (!renderer)
+		return;
+
+	for (int upload(0); upload < ASSET_LOADER_UPLOADS_PER_UPDATE; ++upload)
+	{
+		Decoded decoded;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_decoded.empty())
+				return;
+
+			decoded = _decoded.front();
+			_decoded.pop_front();
+		}
+
+		/* Already loaded synchronously while it was being decoded */
+		if (_states[decoded.asset.name] != QUEUED)
+		{
+			release(decoded);
+			continue;
+		}
+
+		bool const resident(finish(renderer, decoded));
+		if (!resident && decoded.asset.kind == IMAGE)
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+				"Cannot upload texture \"%s\" : %s",
+				decoded.asset.name.c_str(), SDL_GetError());
+
+		_states[decoded.asset.name] = resident ? RESIDENT : FAILED;
+	}
+}
+
+/* Assets still queued are loaded again here : update() drops the workers' copy */
+void AssetLoader::load(SDL_Renderer * renderer, Manifest const & manifest)
+{
+	if (!renderer)
+		return;
+
+	for (Asset const & asset : manifest)
+	{
+		auto const state(_states.find(asset.name));
+		if (state != _states.end() && state->second != QUEUED)
+			continue;
+
+		if (asset.kind == MUSIC)
+			initDecoder(asset.path);
+		Decoded decoded{ asset, nullptr, nullptr, 0, { nullptr, 0 }, nullptr, {} };
+		if (!findPacked(asset, decoded))
+			decoded = decode(asset);
+
+		bool const resident(finish(renderer, decoded));
+		release(decoded);
+		_states[asset.name] = resident ? RESIDENT : FAILED;
+	}
+}
+
+bool AssetLoader::isDone(Manifest const & manifest) const
+{
+	for (Asset const & asset : manifest)
+	{
+		auto const state(_states.find(asset.name));
+		if (state == _states.end() || state->second == QUEUED)
+			return false;
+	}
+
+	return true;
+}
+
+double AssetLoader::getProgress(Manifest const & manifest) const
+{
+	if (manifest.empty())
+		return 1.;
+
+	std::size_t done(0);
+	for (Asset const & asset : manifest)
+	{
+		auto const state(_states.find(asset.name));
+		if (state != _states.end() && state->second != QUEUED)
+			++done;
+	}
+
+	return static_cast<double>(done) / manifest.size();
+}
+
+SDL_Texture * AssetLoader::getTexture(std::string const & name) const
+{
+	auto const found(_textures.find(name));
+	return (found == _textures.end()) ? nullptr : found->second;
+}
+
+/* update() only runs under a loading screen : the upload is done here */
+void AssetLoader::reloadTextures(SDL_Renderer * renderer)
+{
+	Manifest manifest;
+
+	for (auto & texture : _textures)
+	{
+		SDL_DestroyTexture(texture.second);
+		_states.erase(texture.first);
+		manifest.push_back(_images[texture.first]);
+	}
+	_textures.clear();
+	_images.clear();
+	++_textureGeneration;
+
+	load(renderer, manifest);
+}
+
+unsigned int AssetLoader::getTextureGeneration(void) const
+{
+	return _textureGeneration;
+}
+
+Mix_Chunk * AssetLoader::getSample(std::string const & name) const
+{
+	auto const found(_samples.find(name));
+	return (found == _samples.end()) ? nullptr : found->second;
+}
+
+Mix_Music * AssetLoader::getMusic(std::string const & name) const
+{
+	auto const found(_musics.find(name));
+	return (found == _musics.end()) ? nullptr : found->second.music;
+}
+
+Blob AssetLoader::getData(std::string const & name) const
+{
+	auto const found(_data.find(name));
+	return (found == _data.end()) ? Blob{ nullptr, 0 } : found->second;
+}
+
+void AssetLoader::playEffect(std::string const & name) const
+{
+	Mix_Chunk * chunk(getSample(name));
+	if (chunk)
+		Mix_PlayChannel(-1, chunk, 0);
+}
+
+void AssetLoader::playMusic(std::string const & name) const
+{
+	Mix_Music * music(getMusic(name));
+	if (music)
+		Mix_PlayMusic(music, -1);
+}
+
+void AssetLoader::clear(void)
+{
+	stopWorkers();
+
+	for (Decoded & decoded : _decoded)
+		release(decoded);
+	_decoded.clear();
+	_queued.clear();
+
+	for (auto & texture : _textures)
+		SDL_DestroyTexture(texture.second);
+	for (auto & sample : _samples)
+		Mix_FreeChunk(sample.second);
+	for (auto & music : _musics)
+		Mix_FreeMusic(music.second.music);
+
+	_textures.clear();
+	_images.clear();
+	_samples.clear();
+	_musics.clear();
+	_data.clear();
+	_states.clear();
+
+	/* Last : packed chunks were playing from the mapping */
+	_pack.reset();
+}
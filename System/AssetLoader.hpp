@@ -0,0 +1,159 @@
+#ifndef ASSET_LOADER_HPP_INCLUDED
+#define ASSET_LOADER_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include "AssetPack.hpp"
+#include "Blob.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Decoding threads, whatever the core count */
+#define ASSET_LOADER_MAX_WORKERS 4
+
+/* Render-thread work per update is bounded so that loading never hitches */
+#define ASSET_LOADER_UPLOADS_PER_UPDATE 4
+
+/*
+ * Loads assets off the render thread. Workers decode PNGs into surfaces,
+ * WAV samples into PCM and read font & music files into memory; update()
+ * then finishes each asset on the render thread (texture upload, font
+ * registration with the TextCache, sample conversion to the mixer's format,
+ * music stream opening). SDL_mixer is only ever called from there.
+ *
+ * Assets found in the AssetPack skip the workers : their pixels, PCM and
+ * file bytes are used straight from the mapping. Loose files remain the
+ * fallback, for development.
+ *
+ * Assets are known by name, which must be unique across kinds. Activities
+ * declare the assets they need as a Manifest (see Loading::Factory).
+ */
+class AssetLoader
+{
+	public:
+		enum Kind
+		{
+			IMAGE,
+			FONT,
+			SAMPLE,
+			MUSIC,
+			DATA
+		};
+
+		struct Asset
+		{
+			Kind kind;
+			std::string name;
+			std::string path;
+		};
+
+		typedef std::vector<Asset> Manifest;
+
+	private:
+		enum State
+		{
+			QUEUED,
+			RESIDENT,
+			FAILED
+		};
+
+		/* A decoded asset, waiting for the render thread */
+		struct Decoded
+		{
+			Asset asset;
+			SDL_Surface * surface;
+			Uint8 * samples;
+			Uint32 length;
+			Blob bytes;
+			AssetPack::Entry const * packed;
+			SDL_AudioSpec spec;
+		};
+
+		struct Music
+		{
+			Mix_Music * music;
+			Blob bytes;
+		};
+
+		std::shared_ptr<AssetPack> _pack;
+
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::deque<Asset> _queued;
+		std::deque<Decoded> _decoded;
+		bool _stopping;
+
+		/* Render thread only */
+		std::unordered_map<std::string, State> _states;
+		std::unordered_map<std::string, SDL_Texture *> _textures;
+		std::unordered_map<std::string, Mix_Chunk *> _samples;
+		std::unordered_map<std::string, Music> _musics;
+		std::unordered_map<std::string, Blob> _data;
+
+		/* Resident images, to upload again when the device is lost */
+		std::unordered_map<std::string, Asset> _images;
+		unsigned int _textureGeneration;
+
+		AssetLoader(void);
+
+		void startWorkers(void);
+		void stopWorkers(void);
+		void work(void);
+
+		static void initDecoder(std::string const & path);
+		static Decoded decode(Asset const & asset);
+		static void release(Decoded & decoded);
+		bool findPacked(Asset const & asset, Decoded & decoded);
+		static Mix_Chunk * createChunk(Decoded const & decoded);
+		bool finish(SDL_Renderer * renderer, Decoded & decoded);
+
+	public:
+		static std::shared_ptr<AssetLoader> getInstance(void);
+		~AssetLoader(void);
+
+		AssetLoader(AssetLoader const &) = delete;
+		AssetLoader & operator=(AssetLoader const &) = delete;
+
+		void setPack(std::shared_ptr<AssetPack> pack);
+		void request(Manifest const & manifest);
+		void update(SDL_Renderer * renderer);
+
+		/*
+		 * Makes the assets not done yet resident right away, on the render
+		 * thread : for contexts pushed without a loading screen.
+		 */
+		void load(SDL_Renderer * renderer, Manifest const & manifest);
+
+		/* Failed assets count as done : their users fall back or skip them */
+		bool isDone(Manifest const & manifest) const;
+		double getProgress(Manifest const & manifest) const;
+
+		SDL_Texture * getTexture(std::string const & name) const;
+
+		/*
+		 * On device loss : every texture is uploaded again, under a new
+		 * generation. Sheets made from the old ones must be made again.
+		 */
+		void reloadTextures(SDL_Renderer * renderer);
+		unsigned int getTextureGeneration(void) const;
+		Mix_Chunk * getSample(std::string const & name) const;
+		Mix_Music * getMusic(std::string const & name) const;
+		Blob getData(std::string const & name) const;
+
+		static Blob readFile(std::string const & path);
+
+		void playEffect(std::string const & name) const;
+		void playMusic(std::string const & name) const;
+
+		/* Stops the workers & frees everything, before the renderer goes */
+		void clear(void);
+};
+
+#endif // ASSET_LOADER_HPP_INCLUDED
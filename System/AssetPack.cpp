@@ -0,0 +1,195 @@
+#include "AssetPack.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(AssetPack::Header) == 16, "AssetPack header layout");
+static_assert(sizeof(AssetPack::Entry) == 80, "AssetPack entry layout");
+
+AssetPack::AssetPack(void) :
+	_mapping(nullptr),
+	_size(0),
+#ifdef _WIN32
+	_file(INVALID_HANDLE_VALUE),
+	_view(nullptr)
+#else
+	_file(-1)
+#endif
+{}
+
+AssetPack::~AssetPack(void)
+{
+	unmap();
+}
+
+void AssetPack::unmap(void)
+{
+	_entries.clear();
+
+#ifdef _WIN32
+	if (_mapping)
+		UnmapViewOfFile(_mapping);
+	if (_view)
+		CloseHandle(_view);
+	if (_file != INVALID_HANDLE_VALUE)
+		CloseHandle(_file);
+	_view = nullptr;
+	_file = INVALID_HANDLE_VALUE;
+#else
+	if (_mapping)
+		munmap(const_cast<char *>(_mapping), _size);
+	if (_file >= 0)
+		close(_file);
+	_file = -1;
+#endif
+
+	_mapping = nullptr;
+	_size = 0;
+}
+
+bool AssetPack::open(std::string const & path)
+{
+	unmap();
+
+#ifdef _WIN32
+	LARGE_INTEGER size;
+
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size))
+	{
+		unmap();
+		return false;
+	}
+
+	_size = static_cast<std::size_t>(size.QuadPart);
+	_view = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_view)
+		_mapping = static_cast<char const *>(
+			MapViewOfFile(_view, FILE_MAP_READ, 0, 0, 0));
+#else
+	struct stat status;
+
+	_file = ::open(path.c_str(), O_RDONLY);
+	if (_file < 0 || fstat(_file, &status) != 0)
+	{
+		unmap();
+		return false;
+	}
+
+	_size = static_cast<std::size_t>(status.st_size);
+	void * mapping(mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0));
+	if (mapping != MAP_FAILED)
+		_mapping = static_cast<char const *>(mapping);
+#endif
+
+	if (!_mapping)
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_SYSTEM,
+			"Cannot map asset pack \"%s\"", path.c_str());
+		unmap();
+		return false;
+	}
+
+	/* Validate the whole table once : lookups then trust it */
+	Header const * header(reinterpret_cast<Header const *>(_mapping));
+	if (_size < sizeof(Header)
+		|| std::memcmp(header->magic, ASSET_PACK_MAGIC, 4) != 0
+		|| header->version != ASSET_PACK_VERSION
+		|| header->count > (_size - sizeof(Header)) / sizeof(Entry))
+	{
+		SDL_LogError(SDL_LOG_CATEGORY_SYSTEM,
+			"\"%s\" is not a version %d asset pack",
+			path.c_str(), ASSET_PACK_VERSION);
+		unmap();
+		return false;
+	}
+
+	Entry const * entries(reinterpret_cast<Entry const *>(header + 1));
+	for (Uint32 index(0); index < header->count; ++index)
+	{
+		Entry const & entry(entries[index]);
+
+		if (entry.offset > _size || entry.size > _size - entry.offset
+			|| entry.name[ASSET_PACK_NAME_SIZE - 1] != '\0')
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_SYSTEM,
+				"Asset pack \"%s\" : entry %u is corrupted", path.c_str(), index);
+			unmap();
+			return false;
+		}
+
+		if (!isValid(entry))
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_SYSTEM,
+				"Asset pack \"%s\" : entry \"%s\" is invalid, skipped",
+				path.c_str(), entry.name);
+			continue;
+		}
+
+		_entries[entry.name] = &entry;
+	}
+
+	return true;
+}
+
+/* Data within the mapping already checked : does it hold what the kind says */
+bool AssetPack::isValid(Entry const & entry)
+{
+	switch (entry.kind)
+	{
+		case PIXELS:
+		{
+			Uint64 const bytesPerPixel(SDL_BYTESPERPIXEL(entry.format));
+
+			return bytesPerPixel && entry.width && entry.height
+				&& entry.pitch >= entry.width * bytesPerPixel
+				&& static_cast<Uint64>(entry.pitch) * entry.height <= entry.size;
+		}
+
+		/* Whole frames only, a frame being one sample per channel */
+		case PCM:
+		{
+			Uint64 const frame((SDL_AUDIO_BITSIZE(entry.format) / 8)
+				* static_cast<Uint64>(entry.height));
+
+			return entry.width && frame && !(entry.size % frame);
+		}
+
+		case BLOB:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool AssetPack::isOpen(void) const
+{
+	return _mapping != nullptr;
+}
+
+AssetPack::Entry const * AssetPack::find(std::string const & name) const
+{
+	auto const found(_entries.find(name));
+	return (found == _entries.end()) ? nullptr : found->second;
+}
+
+char const * AssetPack::getData(Entry const & entry) const
+{
+	return _mapping + entry.offset;
+}
+
+/* The blob keeps the whole pack mapped */
+Blob AssetPack::getBlob(Entry const & entry)
+{
+	return { std::shared_ptr<char const>(shared_from_this(), getData(entry)),
+		static_cast<std::size_t>(entry.size) };
+}
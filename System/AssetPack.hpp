@@ -0,0 +1,94 @@
+#ifndef ASSET_PACK_HPP_INCLUDED
+#define ASSET_PACK_HPP_INCLUDED
+
+#include "Blob.hpp"
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#define ASSET_PACK_MAGIC "OPAK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_PATH "assets/assets.opak"
+#define ASSET_PACK_NAME_SIZE 40
+
+/* Every entry's data starts on such a boundary */
+#define ASSET_PACK_ALIGNMENT 16
+
+/*
+ * Read-only, memory-mapped archive of pre-processed assets, written by
+ * Tools/Packer.cpp. Entry data is used in place : nothing is copied out of
+ * the mapping, which lives as long as the pack or any Blob taken from it.
+ *
+ * File layout, native byte order : a Header, <count> Entries, then each
+ * entry's data at its offset :
+ * - PIXELS : <height> rows of <pitch> bytes, in SDL pixel <format>
+ * - BLOB : a whole file (font, music), opened from memory
+ * - PCM : samples in SDL audio <format>, <frequency> Hz, <channels>
+ *
+ * An entry whose data does not match its kind is left out : its asset is
+ * then loaded from the loose file.
+ */
+class AssetPack : public std::enable_shared_from_this<AssetPack>
+{
+	public:
+		enum Kind
+		{
+			PIXELS = 1,
+			BLOB = 2,
+			PCM = 3
+		};
+
+		struct Header
+		{
+			char magic[4];
+			Uint32 version;
+			Uint32 count;
+			Uint32 reserved;
+		};
+
+		struct Entry
+		{
+			char name[ASSET_PACK_NAME_SIZE];
+			Uint32 kind;
+			Uint32 format;
+			/* PIXELS : width, height & pitch ; PCM : frequency & channels */
+			Uint32 width;
+			Uint32 height;
+			Uint32 pitch;
+			Uint32 reserved;
+			Uint64 offset;
+			Uint64 size;
+		};
+
+	private:
+		char const * _mapping;
+		std::size_t _size;
+#ifdef _WIN32
+		void * _file;
+		void * _view;
+#else
+		int _file;
+#endif
+
+		std::unordered_map<std::string, Entry const *> _entries;
+
+		void unmap(void);
+		static bool isValid(Entry const & entry);
+
+	public:
+		AssetPack(void);
+		~AssetPack(void);
+
+		AssetPack(AssetPack const &) = delete;
+		AssetPack & operator=(AssetPack const &) = delete;
+
+		bool open(std::string const & path);
+		bool isOpen(void) const;
+
+		Entry const * find(std::string const & name) const;
+		char const * getData(Entry const & entry) const;
+		Blob getBlob(Entry const & entry);
+};
+
+#endif // ASSET_PACK_HPP_INCLUDED
@@ -0,0 +1,895 @@
+#include "Benchmark.hpp"
+#include "FrameProfiler.hpp"
+#include "JobSystem.hpp"
+#include "../GameContext.hpp"
+#include "../Graphics/CommandBuffer.hpp"
+#include "../Graphics/RendererAccess.hpp"
+#include "../Input/InputService.hpp"
+#include "../Activities/Tank.hpp"
+#include "../Activities/TextDebug.hpp"
+#include <VBN/EngineUpdate.hpp>
+#include <VBN/Platform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <iterator>
+
+Benchmark::Benchmark(std::shared_ptr<Platform> platform, unsigned int const frames) :
+	_platform(platform),
+	_frames(frames)
+{
+	/* Per-stage frame times of each scenario under synthetic input */
+	addSuite("frames", [this](std::ostream & output)
+	{
+		for (Scenario const & scenario : _scenarios)
+			runScenario(scenario, output);
+	});
+
+	/*
+	 * Events per second each scenario's handler chain takes : one event at
+	 * a time, with motion batched per frame, and with batches coalesced.
+	 */
+	addSuite("dispatch", [this](std::ostream & output)
+	{
+		for (Scenario const & scenario : _scenarios)
+		{
+			runDispatchScenario(scenario, SINGLE, output);
+			runDispatchScenario(scenario, BATCHED, output);
+			runDispatchScenario(scenario, COALESCED, output);
+		}
+	});
+
+	/*
+	 * Real time with no input at all, once with idle mode and once without :
+	 * CPU usage & displayed frames per second.
+	 */
+	addSuite("idle", [this](std::ostream & output)
+	{
+		for (Scenario const & scenario : _idleScenarios)
+		{
+			runIdleScenario(scenario, true, output);
+			runIdleScenario(scenario, false, output);
+		}
+	});
+
+	/*
+	 * 1 to BENCHMARK_MAX_PLAYERS virtual controllers moving every stick &
+	 * button each frame : cost of dispatching the resulting events & of the
+	 * input snapshot per frame.
+	 */
+	addSuite("players", [this](std::ostream & output)
+	{
+		for (Scenario const & scenario : _playerScenarios)
+			for (int players(1); players <= BENCHMARK_MAX_PLAYERS; players *= 2)
+				runPlayerScenario(scenario, players, output);
+	});
+
+	/*
+	 * 1 to BENCHMARK_MAX_TANKS AI tanks stepped with the vectorized kernel
+	 * then the scalar one : time per step.
+	 */
+	addSuite("tanks", [this](std::ostream & output)
+	{
+		for (std::size_t tanks(1); tanks <= BENCHMARK_MAX_TANKS; tanks *= 10)
+		{
+			runTankScenario(tanks, true, output);
+			runTankScenario(tanks, false, output);
+		}
+	});
+
+	/*
+	 * Swarms of constant density, the arena growing with the tank count :
+	 * broadphase time per step against all-pairs checks.
+	 */
+	addSuite("collision", [this](std::ostream & output)
+	{
+		for (std::size_t tanks(1); tanks <= BENCHMARK_MAX_TANKS; tanks *= 10)
+		{
+			runCollisionScenario(tanks, false, output);
+			if (tanks <= BENCHMARK_MAX_BRUTE_FORCE)
+				runCollisionScenario(tanks, true, output);
+		}
+	});
+
+	/*
+	 * The vectorized tank kernel against the scalar one, from the same
+	 * swarm over BENCHMARK_CHECK_STEPS steps : largest position gap, in
+	 * nanopixels, and heading gap, in nanodegrees. "tanks" times both.
+	 */
+	addSuite("kernel-check", [this](std::ostream & output)
+	{
+		for (std::size_t tanks(1); tanks <= TANK_SWARM_SIZE; tanks *= 10)
+			runKernelCheck(tanks, output);
+		runKernelCheck(TANK_SWARM_SIZE, output);
+	});
+
+	/*
+	 * The broadphase against all-pairs checks, fast movers included :
+	 * pairs and per-box query results either finds but not the other, per
+	 * step. Anything but 0 is a bug.
+	 */
+	addSuite("collision-check", [this](std::ostream & output)
+	{
+		for (std::size_t tanks(10); tanks <= BENCHMARK_MAX_BRUTE_FORCE; tanks *= 10)
+			runCollisionCheck(tanks, output);
+	});
+
+	/*
+	 * Swarms in arenas 1 to BENCHMARK_MAX_RENDER_SPREAD times the window's
+	 * size : frame time against the number of tanks drawn & culled.
+	 */
+	addSuite("render", [this](std::ostream & output)
+	{
+		for (std::size_t tanks(100); tanks <= BENCHMARK_MAX_RENDERED_TANKS;
+			tanks *= 10)
+			for (int spread(1); spread <= BENCHMARK_MAX_RENDER_SPREAD; spread *= 2)
+				runRenderScenario(tanks, spread, output);
+	});
+
+	/*
+	 * The job system from 1 thread to one per core : the tank model's step
+	 * time, then a task graph's, per store the per-tank passes then the
+	 * broadphase depending on them.
+	 */
+	addSuite("jobs", [this](std::ostream & output)
+	{
+		unsigned int const cores(static_cast<unsigned int>(
+			std::max(1, SDL_GetCPUCount())));
+
+		for (unsigned int threads(1); threads < cores; threads *= 2)
+			runJobScenario(threads, output);
+		runJobScenario(cores, output);
+
+		/* Back to the default pool, started on the next job */
+		JobSystem::getInstance()->stop();
+	});
+
+	/*
+	 * The text debug view's paragraph drawn from the glyph atlases, then
+	 * rasterized with TTF every frame : frame time of each.
+	 */
+	addSuite("text", [this](std::ostream & output)
+	{
+		runTextScenario(true, output);
+		runTextScenario(false, output);
+	});
+}
+
+void Benchmark::addScenario(std::string const & name, Factory factory)
+{
+	_scenarios.push_back({ name, factory });
+}
+
+void Benchmark::addIdleScenario(std::string const & name, Factory factory)
+{
+	_idleScenarios.push_back({ name, factory });
+}
+
+void Benchmark::addPlayerScenario(std::string const & name, Factory factory)
+{
+	_playerScenarios.push_back({ name, factory });
+}
+
+void Benchmark::addSuite(std::string const & name, Suite suite)
+{
+	_suites.push_back({ name, suite });
+}
+
+bool Benchmark::run(std::ostream & output, std::string const & suite)
+{
+	bool found(false);
+
+	for (NamedSuite const & named : _suites)
+		if (suite.empty() || named.name == suite)
+		{
+			named.suite(output);
+			found = true;
+		}
+
+	return found;
+}
+
+std::vector<std::string> Benchmark::getSuites(void) const
+{
+	std::vector<std::string> names;
+
+	for (NamedSuite const & named : _suites)
+		names.push_back(named.name);
+
+	return names;
+}
+
+/*
+ * Input that exercises every handler chain without requesting context
+ * changes : mouse motion and a stick sweep every frame, and an up/down key
+ * press every 30 frames.
+ */
+void Benchmark::synthesizeInput(unsigned int const frame,
+	std::shared_ptr<GameContext> context,
+	std::shared_ptr<EngineUpdate> engineUpdate)
+{
+	SDL_Event event{};
+
+	event.type = SDL_MOUSEMOTION;
+	event.motion.x = static_cast<Sint32>(frame % 800);
+	event.motion.y = static_cast<Sint32>(frame % 450);
+	event.motion.xrel = 1;
+	event.motion.yrel = 1;
+	context->handleEvent(event, engineUpdate);
+
+	event = SDL_Event{};
+	event.type = SDL_CONTROLLERAXISMOTION;
+	event.caxis.which = 0;
+	event.caxis.axis = SDL_CONTROLLER_AXIS_LEFTX;
+	event.caxis.value = static_cast<Sint16>(((frame * 1024) % 65536) - 32768);
+	context->handleEvent(event, engineUpdate);
+
+	if (frame % 30 == 0)
+	{
+		event = SDL_Event{};
+		event.type = SDL_KEYDOWN;
+		event.key.keysym.sym = (frame % 60 == 0) ? SDLK_DOWN : SDLK_UP;
+		context->handleEvent(event, engineUpdate);
+
+		event.type = SDL_KEYUP;
+		context->handleEvent(event, engineUpdate);
+	}
+}
+
+void Benchmark::runScenario(Scenario const & scenario, std::ostream & output)
+{
+	std::shared_ptr<FrameProfiler> profiler(FrameProfiler::getInstance());
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::shared_ptr<GameContext> context(scenario.factory(_platform));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	std::vector<std::vector<double>> samples(FrameProfiler::NB_STAGES);
+	std::vector<double> recorded, calls;
+	double const msPerCount(profiler->getMillisecondsPerCount());
+
+	/* Frame 0 only opens the profiler window and warms caches up */
+	profiler->setEnabled(true);
+	for (unsigned int frame(0); frame <= _frames; ++frame)
+	{
+		synthesizeInput(frame, context, engineUpdate);
+		context->elapse(BENCHMARK_FRAME_TICKS, engineUpdate);
+		context->display();
+
+		if (!frame)
+			continue;
+
+		for (unsigned int stage(0); stage < FrameProfiler::NB_STAGES; ++stage)
+			samples[stage].push_back(msPerCount
+				* profiler->getLastSample(static_cast<FrameProfiler::Stage>(stage)));
+
+		recorded.push_back(commands->getSubmittedCommands());
+		calls.push_back(commands->getSubmittedCalls());
+	}
+	profiler->setEnabled(false);
+
+	for (unsigned int stage(0); stage < FrameProfiler::NB_STAGES; ++stage)
+		report(output, scenario.name,
+			FrameProfiler::getStageName(static_cast<FrameProfiler::Stage>(stage)),
+			samples[stage]);
+
+	/* Sub-view draw commands, and the SDL calls they were merged into */
+	report(output, scenario.name, "draw-commands", recorded);
+	report(output, scenario.name, "draw-calls", calls);
+}
+
+/* Same loop shape as the engine's : events, elapse, display */
+void Benchmark::runIdleScenario(Scenario const & scenario,
+	bool const idle,
+	std::ostream & output)
+{
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::shared_ptr<GameContext> context(scenario.factory(_platform));
+	std::vector<double> cpu, frames;
+	SDL_Event event;
+
+	context->setIdleEnabled(idle);
+
+	Uint32 last(SDL_GetTicks()), windowStart(last);
+	std::clock_t cpuStart(std::clock());
+	Uint64 framesStart(context->getDisplayedFrames());
+
+	while (cpu.size() < BENCHMARK_IDLE_SECONDS)
+	{
+		while (SDL_PollEvent(&event))
+			context->handleEvent(event, engineUpdate);
+
+		Uint32 const now(SDL_GetTicks());
+		context->elapse(now - last, engineUpdate);
+		last = now;
+		context->display();
+
+		Uint32 const end(SDL_GetTicks());
+		if (end - windowStart < 1000)
+			continue;
+
+		std::clock_t const cpuEnd(std::clock());
+		double const seconds((end - windowStart) / 1000.);
+		cpu.push_back((100. * (cpuEnd - cpuStart)) / (CLOCKS_PER_SEC * seconds));
+		frames.push_back((context->getDisplayedFrames() - framesStart) / seconds);
+
+		windowStart = end;
+		cpuStart = cpuEnd;
+		framesStart = context->getDisplayedFrames();
+	}
+
+	std::string const name(scenario.name + (idle ? "-idle" : "-busy"));
+	report(output, name, "cpu-percent", cpu);
+	report(output, name, "frames-per-second", frames);
+}
+
+/*
+ * Mostly motion, as a moving mouse and stick produce, with a mouse button
+ * press or release every 16 events. Nothing that changes contexts.
+ */
+std::vector<SDL_Event> Benchmark::synthesizeBurst(void)
+{
+	std::vector<SDL_Event> events(BENCHMARK_DISPATCH_EVENTS);
+
+	for (unsigned int index(0); index < BENCHMARK_DISPATCH_EVENTS; ++index)
+	{
+		SDL_Event & event(events[index]);
+
+		event = SDL_Event{};
+		if (index % 16 == 15)
+		{
+			event.type = (index % 32 == 15) ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+			event.button.button = SDL_BUTTON_LEFT;
+		}
+		else if (index % 2)
+		{
+			event.type = SDL_CONTROLLERAXISMOTION;
+			event.caxis.axis = static_cast<Uint8>(index % SDL_CONTROLLER_AXIS_MAX);
+			event.caxis.value = static_cast<Sint16>(((index * 1024) % 65536) - 32768);
+		}
+		else
+		{
+			event.type = SDL_MOUSEMOTION;
+			event.motion.x = static_cast<Sint32>(index % 800);
+			event.motion.y = static_cast<Sint32>(index % 450);
+			event.motion.xrel = 1;
+			event.motion.yrel = 1;
+		}
+	}
+
+	return events;
+}
+
+/*
+ * Through GameContext::handleEvent, as the engine delivers them. Batched,
+ * motion waits for the end of the round as it would for the frame's elapse ;
+ * otherwise every event is flushed on arrival. Round 0 warms caches up.
+ */
+void Benchmark::runDispatchScenario(Scenario const & scenario,
+	Dispatch const dispatch,
+	std::ostream & output)
+{
+	static char const * const METRICS[] = {
+		"dispatch-events-per-second",
+		"dispatch-batched-events-per-second",
+		"dispatch-coalesced-events-per-second" };
+
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::shared_ptr<GameContext> context(scenario.factory(_platform));
+	std::vector<SDL_Event> const events(synthesizeBurst());
+	std::vector<double> rates;
+	double const frequency(static_cast<double>(SDL_GetPerformanceFrequency()));
+
+	context->setCoalescing(dispatch == COALESCED);
+
+	for (unsigned int round(0); round <= BENCHMARK_DISPATCH_ROUNDS; ++round)
+	{
+		Uint64 const start(SDL_GetPerformanceCounter());
+
+		for (SDL_Event const & event : events)
+		{
+			context->handleEvent(event, engineUpdate);
+			if (dispatch == SINGLE)
+				context->flushEvents(*engineUpdate);
+		}
+		context->flushEvents(*engineUpdate);
+
+		Uint64 const ticks(SDL_GetPerformanceCounter() - start);
+		if (round && ticks)
+			rates.push_back((events.size() * frequency) / ticks);
+	}
+
+	report(output, scenario.name, METRICS[dispatch], rates);
+}
+
+void Benchmark::pumpEvents(std::shared_ptr<GameContext> context,
+	std::shared_ptr<EngineUpdate> engineUpdate)
+{
+	SDL_Event event;
+
+	while (SDL_PollEvent(&event))
+		context->handleEvent(event, engineUpdate);
+	context->flushEvents(*engineUpdate);
+}
+
+/*
+ * Hotplug goes through the context's handlers as in the game, so the
+ * virtual controllers get player slots the usual way.
+ */
+void Benchmark::runPlayerScenario(Scenario const & scenario,
+	int const players,
+	std::ostream & output)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::shared_ptr<GameContext> context(scenario.factory(_platform));
+	std::shared_ptr<InputService> input(InputService::getInstance());
+	std::vector<SDL_Joystick *> joysticks;
+	std::vector<int> devices;
+	std::vector<double> dispatch, snapshot, events;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+	std::string const name(scenario.name + "-" + std::to_string(players) + "p");
+
+	SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER);
+
+	for (int player(0); player < players; ++player)
+	{
+		int const device(SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_GAMECONTROLLER,
+			SDL_CONTROLLER_AXIS_MAX, SDL_CONTROLLER_BUTTON_MAX, 0));
+		if (device < 0)
+			break;
+		devices.push_back(device);
+	}
+	pumpEvents(context, engineUpdate);
+
+	for (int device : devices)
+	{
+		SDL_Joystick * joystick(SDL_JoystickFromInstanceID(
+			SDL_JoystickGetDeviceInstanceID(device)));
+		if (joystick)
+			joysticks.push_back(joystick);
+	}
+
+	if (input->getConnectedPlayers() < players)
+		SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
+			"Benchmark %s : only %d of %d virtual controllers connected",
+			name.c_str(), input->getConnectedPlayers(), players);
+
+	for (unsigned int frame(0); frame <= _frames; ++frame)
+	{
+		Sint16 const value(static_cast<Sint16>(((frame * 1024) % 65536) - 32768));
+		unsigned int dispatched(0);
+		SDL_Event event;
+
+		for (SDL_Joystick * joystick : joysticks)
+		{
+			for (int axis(0); axis < SDL_CONTROLLER_AXIS_MAX; ++axis)
+				SDL_JoystickSetVirtualAxis(joystick, axis, value);
+			SDL_JoystickSetVirtualButton(joystick, frame % SDL_CONTROLLER_BUTTON_MAX,
+				(frame / SDL_CONTROLLER_BUTTON_MAX) % 2 ? SDL_PRESSED : SDL_RELEASED);
+		}
+		SDL_JoystickUpdate();
+
+		Uint64 const start(SDL_GetPerformanceCounter());
+		while (SDL_PollEvent(&event))
+		{
+			context->handleEvent(event, engineUpdate);
+			++dispatched;
+		}
+		context->flushEvents(*engineUpdate);
+		Uint64 const dispatchEnd(SDL_GetPerformanceCounter());
+		input->update();
+		input->getSnapshot();
+		Uint64 const snapshotEnd(SDL_GetPerformanceCounter());
+
+		if (!frame)
+			continue;
+
+		dispatch.push_back(msPerCount * (dispatchEnd - start));
+		snapshot.push_back(msPerCount * (snapshotEnd - dispatchEnd));
+		events.push_back(dispatched);
+	}
+
+	/* Last attached first : device indices shift as devices go */
+	for (auto device(devices.rbegin()); device != devices.rend(); ++device)
+		SDL_JoystickDetachVirtual(*device);
+	pumpEvents(context, engineUpdate);
+	SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
+
+	report(output, name, "input-dispatch", dispatch);
+	report(output, name, "input-snapshot", snapshot);
+	report(output, name, "input-events", events);
+#else
+	SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
+		"Benchmark %s : virtual controllers need SDL 2.0.14",
+		scenario.name.c_str());
+#endif
+}
+
+/* Simulation only, at the Tank activity's fixed rate. Step 0 warms caches up */
+void Benchmark::runTankScenario(std::size_t const tanks,
+	bool const vectorized,
+	std::ostream & output)
+{
+	Tank::Store store;
+	std::vector<double> steps;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+	Uint32 const gameTicks(1000 / TANK_SIMULATION_RATE);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
+
+	store.spawn(tanks, TANK_ARENA_WIDTH, TANK_ARENA_HEIGHT, TANK_SWARM_RADIUS);
+
+	for (unsigned int step(0); step <= _frames; ++step)
+	{
+		Uint64 const start(SDL_GetPerformanceCounter());
+
+		store.steer(gameTicks, 0, store.size(), TANK_ARENA_WIDTH, TANK_ARENA_HEIGHT);
+		if (vectorized)
+			store.integrate(scale);
+		else
+			store.integrateScalar(scale);
+
+		if (step)
+			steps.push_back(msPerCount * (SDL_GetPerformanceCounter() - start));
+	}
+
+	report(output, "tank-store-" + std::to_string(tanks),
+		vectorized ? "step" : "step-scalar", steps);
+}
+
+/* Detection only : the pairs found are not resolved */
+void Benchmark::runCollisionScenario(std::size_t const tanks,
+	bool const bruteForce,
+	std::ostream & output)
+{
+	Tank::Store store;
+	SpatialHash hash(TANK_CELL_SIZE);
+	std::vector<SpatialHash::Box> boxes;
+	std::vector<SpatialHash::Pair> pairs;
+	std::vector<double> steps, found, memory;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+	Uint32 const gameTicks(1000 / TANK_SIMULATION_RATE);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
+	double const side(std::sqrt(static_cast<double>(tanks) / TANK_SWARM_SIZE));
+	double const width(TANK_ARENA_WIDTH * side), height(TANK_ARENA_HEIGHT * side);
+
+	store.spawn(tanks, width, height, TANK_SWARM_RADIUS);
+
+	for (unsigned int step(0); step <= _frames; ++step)
+	{
+		store.steer(gameTicks, 0, store.size(), width, height);
+		store.integrate(scale);
+
+		Uint64 const start(SDL_GetPerformanceCounter());
+		store.sweep(boxes);
+		if (bruteForce)
+		{
+			pairs.clear();
+			for (Uint32 first(0); first < boxes.size(); ++first)
+				for (Uint32 second(first + 1); second < boxes.size(); ++second)
+					if (SpatialHash::overlap(boxes[first], boxes[second]))
+						pairs.push_back({ first, second });
+		}
+		else
+		{
+			hash.build(boxes);
+			hash.findPairs(pairs);
+		}
+		Uint64 const end(SDL_GetPerformanceCounter());
+
+		store.confine(width, height);
+		if (!step)
+			continue;
+
+		steps.push_back(msPerCount * (end - start));
+		found.push_back(pairs.size());
+		memory.push_back(hash.getMemoryUsage() / 1024.);
+	}
+
+	std::string const name("tank-collisions-" + std::to_string(tanks));
+	if (bruteForce)
+		report(output, name, "brute-force", steps);
+	else
+	{
+		report(output, name, "broadphase", steps);
+		report(output, name, "pairs", found);
+		report(output, name, "hash-kib", memory);
+	}
+}
+
+/* Both kernels steer the same way as long as positions agree */
+void Benchmark::runKernelCheck(std::size_t const tanks, std::ostream & output)
+{
+	Tank::Store vectorized;
+	Uint32 const gameTicks(1000 / TANK_SIMULATION_RATE);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
+	std::vector<double> positionGaps, headingGaps;
+
+	vectorized.spawn(tanks, TANK_ARENA_WIDTH, TANK_ARENA_HEIGHT, TANK_SWARM_RADIUS);
+	Tank::Store scalar(vectorized);
+
+	for (unsigned int step(0); step < BENCHMARK_CHECK_STEPS; ++step)
+	{
+		double positionGap(0.), headingGap(0.);
+
+		vectorized.steer(gameTicks, 0, vectorized.size(),
+			TANK_ARENA_WIDTH, TANK_ARENA_HEIGHT);
+		scalar.steer(gameTicks, 0, scalar.size(),
+			TANK_ARENA_WIDTH, TANK_ARENA_HEIGHT);
+		vectorized.integrate(scale);
+		scalar.integrateScalar(scale);
+
+		for (std::size_t tank(0); tank < tanks; ++tank)
+		{
+			positionGap = std::max(positionGap, std::max(
+				std::fabs(vectorized.x[tank] - scalar.x[tank]),
+				std::fabs(vectorized.y[tank] - scalar.y[tank])));
+			headingGap = std::max(headingGap,
+				std::fabs(vectorized.dir[tank] - scalar.dir[tank]));
+		}
+
+		positionGaps.push_back(positionGap * 1e9);
+		headingGaps.push_back(headingGap * 1e9);
+	}
+
+	std::string const name("tank-kernel-" + std::to_string(tanks));
+	report(output, name, "position-gap-npx", positionGaps);
+	report(output, name, "heading-gap-ndeg", headingGaps);
+}
+
+/*
+ * Swarm steps as in the collision scenarios, a few tanks being thrown half
+ * the arena away after each : their sweeps span too many cells to be
+ * hashed, and go through the broadphase's oversized path.
+ */
+void Benchmark::runCollisionCheck(std::size_t const tanks, std::ostream & output)
+{
+	Tank::Store store;
+	SpatialHash hash(TANK_CELL_SIZE);
+	std::vector<SpatialHash::Box> boxes;
+	std::vector<SpatialHash::Pair> pairs, expected;
+	std::vector<Uint32> found, overlapping;
+	std::vector<double> pairMisses, queryMisses, oversized;
+	Uint32 const gameTicks(1000 / TANK_SIMULATION_RATE);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
+	double const side(std::sqrt(static_cast<double>(tanks) / TANK_SWARM_SIZE));
+	double const width(TANK_ARENA_WIDTH * side), height(TANK_ARENA_HEIGHT * side);
+	auto const byIndices([](SpatialHash::Pair const & a, SpatialHash::Pair const & b)
+	{
+		return (a.first != b.first) ? a.first < b.first : a.second < b.second;
+	});
+
+	store.spawn(tanks, width, height, TANK_SWARM_RADIUS);
+
+	for (unsigned int step(0); step < BENCHMARK_CHECK_STEPS; ++step)
+	{
+		store.steer(gameTicks, 0, store.size(), width, height);
+		store.integrate(scale);
+		for (std::size_t tank(step % BENCHMARK_CHECK_FAST_MOVERS); tank < tanks;
+			tank += BENCHMARK_CHECK_FAST_MOVERS)
+		{
+			store.x[tank] = std::fmod(store.x[tank] + width / 2., width);
+			store.y[tank] = std::fmod(store.y[tank] + height / 2., height);
+		}
+
+		store.sweep(boxes);
+		hash.build(boxes);
+		hash.findPairs(pairs);
+
+		expected.clear();
+		for (Uint32 first(0); first < boxes.size(); ++first)
+			for (Uint32 second(first + 1); second < boxes.size(); ++second)
+				if (SpatialHash::overlap(boxes[first], boxes[second]))
+					expected.push_back({ first, second });
+
+		std::sort(pairs.begin(), pairs.end(), byIndices);
+		std::vector<SpatialHash::Pair> missed;
+		std::set_symmetric_difference(pairs.begin(), pairs.end(),
+			expected.begin(), expected.end(), std::back_inserter(missed),
+			byIndices);
+		pairMisses.push_back(missed.size());
+
+		std::size_t queryMissed(0);
+		for (SpatialHash::Box const & box : boxes)
+		{
+			hash.query(box, found);
+			overlapping.clear();
+			for (Uint32 index(0); index < boxes.size(); ++index)
+				if (SpatialHash::overlap(box, boxes[index]))
+					overlapping.push_back(index);
+
+			std::sort(found.begin(), found.end());
+			if (found != overlapping)
+				++queryMissed;
+		}
+		queryMisses.push_back(queryMissed);
+		oversized.push_back(hash.getOversized());
+
+		store.confine(width, height);
+	}
+
+	std::string const name("tank-collisions-" + std::to_string(tanks));
+	report(output, name, "pair-mismatches", pairMisses);
+	report(output, name, "query-mismatches", queryMisses);
+	report(output, name, "oversized", oversized);
+}
+
+/*
+ * Tank model & view on their own, without the Global overlays. Rendering
+ * includes the flush to SDL & the present, SDL batching draws until then.
+ */
+void Benchmark::runRenderScenario(std::size_t const tanks,
+	int const spread,
+	std::ostream & output)
+{
+	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
+	SDL_Renderer * renderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	std::pair<int, int> const size(mainWindow->getSize());
+	std::shared_ptr<Tank::Model> model(std::make_shared<Tank::Model>(_platform,
+		tanks, static_cast<double>(size.first) * spread,
+		static_cast<double>(size.second) * spread));
+	Tank::View view(_platform, model);
+	std::vector<double> frames, visible, culled;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+
+	for (unsigned int frame(0); frame <= _frames; ++frame)
+	{
+		model->elapse(1000 / TANK_SIMULATION_RATE, engineUpdate);
+
+		Uint64 const start(SDL_GetPerformanceCounter());
+		commands->begin(renderer);
+		view.display();
+		commands->flush();
+		SDL_RenderPresent(renderer);
+		Uint64 const end(SDL_GetPerformanceCounter());
+
+		if (!frame)
+			continue;
+
+		frames.push_back(msPerCount * (end - start));
+		visible.push_back(view.getVisible());
+		culled.push_back(view.getCulled());
+	}
+
+	std::string const name("tank-render-" + std::to_string(tanks)
+		+ "-x" + std::to_string(spread));
+	report(output, name, "render", frames);
+	report(output, name, "visible", visible);
+	report(output, name, "culled", culled);
+}
+
+/* Text debug view on its own, timed like the tank render scenario */
+void Benchmark::runTextScenario(bool const glyphAtlas, std::ostream & output)
+{
+	Window * mainWindow(_platform->getWindowManager()->getWindowByName("mainWindow"));
+	SDL_Renderer * renderer(getSDLRenderer(mainWindow));
+	std::shared_ptr<CommandBuffer> commands(CommandBuffer::getInstance());
+	std::shared_ptr<TextDebug::Model> model(
+		std::make_shared<TextDebug::Model>(_platform));
+	TextDebug::View view(_platform, model);
+	std::vector<double> frames;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+
+	if (model->getUseGlyphAtlas() != glyphAtlas)
+		model->toggleGlyphAtlas();
+
+	/* The first frame fills the atlases : not counted */
+	for (unsigned int frame(0); frame <= _frames; ++frame)
+	{
+		Uint64 const start(SDL_GetPerformanceCounter());
+		commands->begin(renderer);
+		view.display();
+		commands->flush();
+		SDL_RenderPresent(renderer);
+		Uint64 const end(SDL_GetPerformanceCounter());
+
+		if (frame)
+			frames.push_back(msPerCount * (end - start));
+	}
+
+	report(output, glyphAtlas ? "text-glyph-atlas" : "text-ttf", "render", frames);
+}
+
+void Benchmark::runJobScenario(unsigned int const threads, std::ostream & output)
+{
+	std::shared_ptr<JobSystem> jobs(JobSystem::getInstance());
+	std::shared_ptr<EngineUpdate> engineUpdate(std::make_shared<EngineUpdate>());
+	std::vector<double> model, graph;
+	double const msPerCount(1000. / SDL_GetPerformanceFrequency());
+	Uint32 const gameTicks(1000 / TANK_SIMULATION_RATE);
+	double const scale(gameTicks / TANK_REFERENCE_TICKS);
+
+	/* The swarm's density, over an arena as large as needed */
+	double const side(std::sqrt(static_cast<double>(BENCHMARK_JOB_TANKS)
+		/ TANK_SWARM_SIZE));
+	double const width(TANK_ARENA_WIDTH * side), height(TANK_ARENA_HEIGHT * side);
+	std::shared_ptr<Tank::Model> swarm(std::make_shared<Tank::Model>(_platform,
+		BENCHMARK_JOB_TANKS, width, height));
+
+	/* Stores share the tanks out, each one with its own broadphase */
+	double const storeSide(side / std::sqrt(static_cast<double>(BENCHMARK_JOB_STORES)));
+	double const storeWidth(TANK_ARENA_WIDTH * storeSide);
+	double const storeHeight(TANK_ARENA_HEIGHT * storeSide);
+	std::vector<Tank::Store> stores(BENCHMARK_JOB_STORES);
+	std::vector<SpatialHash> hashes(BENCHMARK_JOB_STORES, SpatialHash(TANK_CELL_SIZE));
+	std::vector<std::vector<SpatialHash::Box>> boxes(BENCHMARK_JOB_STORES);
+	std::vector<std::vector<SpatialHash::Pair>> pairs(BENCHMARK_JOB_STORES);
+	JobSystem::Graph steps;
+
+	for (std::size_t store(0); store < BENCHMARK_JOB_STORES; ++store)
+	{
+		Tank::Store & tanks(stores[store]);
+		tanks.spawn(BENCHMARK_JOB_TANKS / BENCHMARK_JOB_STORES,
+			storeWidth, storeHeight, TANK_SWARM_RADIUS);
+		boxes[store].resize(tanks.size());
+
+		std::size_t const move(steps.add([&, store, scale]
+		{
+			jobs->parallelFor(stores[store].size(), TANK_JOB_GRAIN,
+				[&, store, scale](std::size_t const first, std::size_t const last)
+				{
+					stores[store].steer(gameTicks, first, last, storeWidth, storeHeight);
+					stores[store].integrate(scale, first, last);
+					stores[store].sweep(boxes[store], first, last);
+				});
+		}));
+		steps.add([&, store]
+		{
+			hashes[store].build(boxes[store]);
+			hashes[store].findPairs(pairs[store]);
+			stores[store].resolve(pairs[store], 0);
+			stores[store].confine(storeWidth, storeHeight);
+		}, { move });
+	}
+
+	jobs->start(threads - 1);
+
+	for (unsigned int step(0); step <= _frames; ++step)
+	{
+		Uint64 const start(SDL_GetPerformanceCounter());
+		swarm->elapse(gameTicks, engineUpdate);
+		jobs->joinFrame();
+		Uint64 const modelEnd(SDL_GetPerformanceCounter());
+		steps.run();
+		Uint64 const graphEnd(SDL_GetPerformanceCounter());
+
+		if (!step)
+			continue;
+
+		model.push_back(msPerCount * (modelEnd - start));
+		graph.push_back(msPerCount * (graphEnd - modelEnd));
+	}
+
+	std::string const name("jobs-" + std::to_string(threads) + "t");
+	report(output, name, "tank-model-step", model);
+	report(output, name, "task-graph-step", graph);
+}
+
+void Benchmark::report(std::ostream & output,
+	std::string const & scenario,
+	std::string const & metric,
+	std::vector<double> & samples)
+{
+	double sum(0.);
+
+	if (samples.empty())
+		return;
+
+	std::sort(samples.begin(), samples.end());
+	for (double sample : samples)
+		sum += sample;
+
+	std::size_t const last(samples.size() - 1);
+	output << std::fixed << std::setprecision(4)
+		<< "{\"scenario\":\"" << scenario << "\""
+		<< ",\"metric\":\"" << metric << "\""
+		<< ",\"count\":" << samples.size()
+		<< ",\"min\":" << samples.front()
+		<< ",\"avg\":" << sum / samples.size()
+		<< ",\"p50\":" << samples[last / 2]
+		<< ",\"p90\":" << samples[(last * 90) / 100]
+		<< ",\"p99\":" << samples[(last * 99) / 100]
+		<< ",\"max\":" << samples.back()
+		<< "}" << std::endl;
+}
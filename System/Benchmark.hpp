@@ -0,0 +1,137 @@
+#ifndef BENCHMARK_HPP_INCLUDED
+#define BENCHMARK_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define BENCHMARK_DEFAULT_FRAMES 600
+#define BENCHMARK_FRAME_TICKS 16
+
+/* Wall-clock length of each idle measurement, sampled once a second */
+#define BENCHMARK_IDLE_SECONDS 8
+
+/* Dispatch measurements : rounds of one frame's worth of input burst each */
+#define BENCHMARK_DISPATCH_EVENTS 1024
+#define BENCHMARK_DISPATCH_ROUNDS 200
+
+/* Player counts driven through virtual controllers */
+#define BENCHMARK_MAX_PLAYERS 8
+
+/* Tank store sizes, by factors of 10 */
+#define BENCHMARK_MAX_TANKS 100000
+
+/* Beyond that many tanks, all-pairs collision checks take too long to run */
+#define BENCHMARK_MAX_BRUTE_FORCE 1000
+
+/*
+ * Checks against the reference paths : steps run, and 1 tank in so many
+ * thrown across the arena every step, as a very fast mover
+ */
+#define BENCHMARK_CHECK_STEPS 2000
+#define BENCHMARK_CHECK_FAST_MOVERS 50
+
+/* Rendered tank counts from 100, spread over up to 4x the window's side */
+#define BENCHMARK_MAX_RENDERED_TANKS 10000
+#define BENCHMARK_MAX_RENDER_SPREAD 4
+
+/* Job scaling : one swarm model, and a graph of independent stores */
+#define BENCHMARK_JOB_TANKS 100000
+#define BENCHMARK_JOB_STORES 8
+
+class Platform;
+class GameContext;
+class EngineUpdate;
+
+/*
+ * Headless benchmark harness : drives each registered activity for a fixed
+ * number of frames with synthetic input, outside of the Engine loop, and
+ * prints per-stage frame time percentiles (milliseconds) as one JSON object
+ * per line.
+ *
+ * Measurements come in named suites, each documented where it is
+ * registered : run() runs one of them, or all of them in order.
+ */
+class Benchmark
+{
+	public:
+		typedef std::function<std::shared_ptr<GameContext>(
+			std::shared_ptr<Platform>)> Factory;
+		typedef std::function<void(std::ostream & output)> Suite;
+
+	private:
+		enum Dispatch
+		{
+			SINGLE,
+			BATCHED,
+			COALESCED
+		};
+
+		struct Scenario
+		{
+			std::string name;
+			Factory factory;
+		};
+
+		struct NamedSuite
+		{
+			std::string name;
+			Suite suite;
+		};
+
+		std::shared_ptr<Platform> _platform;
+		unsigned int _frames;
+		std::vector<Scenario> _scenarios;
+		std::vector<Scenario> _idleScenarios;
+		std::vector<Scenario> _playerScenarios;
+		std::vector<NamedSuite> _suites;
+
+		void synthesizeInput(unsigned int const frame,
+			std::shared_ptr<GameContext> context,
+			std::shared_ptr<EngineUpdate> engineUpdate);
+		void runScenario(Scenario const & scenario, std::ostream & output);
+		void runIdleScenario(Scenario const & scenario, bool const idle,
+			std::ostream & output);
+		void runDispatchScenario(Scenario const & scenario,
+			Dispatch const dispatch,
+			std::ostream & output);
+
+		void runPlayerScenario(Scenario const & scenario, int const players,
+			std::ostream & output);
+		void runTankScenario(std::size_t const tanks, bool const vectorized,
+			std::ostream & output);
+		void runCollisionScenario(std::size_t const tanks, bool const bruteForce,
+			std::ostream & output);
+		void runKernelCheck(std::size_t const tanks, std::ostream & output);
+		void runCollisionCheck(std::size_t const tanks, std::ostream & output);
+		void runRenderScenario(std::size_t const tanks, int const spread,
+			std::ostream & output);
+		void runJobScenario(unsigned int const threads, std::ostream & output);
+		void runTextScenario(bool const glyphAtlas, std::ostream & output);
+
+		static std::vector<SDL_Event> synthesizeBurst(void);
+		static void pumpEvents(std::shared_ptr<GameContext> context,
+			std::shared_ptr<EngineUpdate> engineUpdate);
+
+	public:
+		Benchmark(std::shared_ptr<Platform> platform, unsigned int const frames);
+
+		void addScenario(std::string const & name, Factory factory);
+		void addIdleScenario(std::string const & name, Factory factory);
+		void addPlayerScenario(std::string const & name, Factory factory);
+		void addSuite(std::string const & name, Suite suite);
+
+		/* Every suite when <suite> is empty ; false if there is no such suite */
+		bool run(std::ostream & output, std::string const & suite = std::string());
+		std::vector<std::string> getSuites(void) const;
+
+		static void report(std::ostream & output,
+			std::string const & scenario,
+			std::string const & metric,
+			std::vector<double> & samples);
+};
+
+#endif // BENCHMARK_HPP_INCLUDED
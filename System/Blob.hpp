@@ -0,0 +1,17 @@
+#ifndef BLOB_HPP_INCLUDED
+#define BLOB_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+
+/*
+ * Read-only bytes and whatever keeps them alive : a file read into memory,
+ * or a mapped AssetPack (the pointer aliases the pack's shared_ptr).
+ */
+struct Blob
+{
+	std::shared_ptr<char const> data;
+	std::size_t size;
+};
+
+#endif // BLOB_HPP_INCLUDED
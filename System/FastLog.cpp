@@ -0,0 +1,435 @@
+#include "FastLog.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+
+std::atomic<int> FastLog::_threshold(SDL_LOG_PRIORITY_INFO);
+std::atomic<bool> FastLog::_sleeping(false);
+
+FastLog::FastLog(void) : _stopping(false)
+{}
+
+FastLog::~FastLog(void)
+{
+	stop();
+}
+
+std::shared_ptr<FastLog> FastLog::getInstance(void)
+{
+	static std::shared_ptr<FastLog> instance(new FastLog);
+	return instance;
+}
+
+void FastLog::setThreshold(SDL_LogPriority const priority)
+{
+	_threshold.store(priority, std::memory_order_relaxed);
+}
+
+/* Created on a thread's first log : the only time it takes the lock */
+FastLog::Ring & FastLog::getRing(void)
+{
+	static thread_local RingOwner owner{ nullptr };
+
+	if (!owner.ring)
+	{
+		std::shared_ptr<FastLog> log(getInstance());
+		std::lock_guard<std::mutex> lock(log->_mutex);
+
+		log->_rings.emplace_back(new Ring);
+		owner.ring = log->_rings.back().get();
+		owner.ring->head = 0;
+		owner.ring->tail = 0;
+		owner.ring->dropped = 0;
+		owner.ring->thread = static_cast<Uint32>(SDL_ThreadID());
+		owner.ring->exited = false;
+	}
+
+	return *owner.ring;
+}
+
+Uint32 FastLog::registerSite(Site & site, char const * format)
+{
+	std::shared_ptr<FastLog> log(getInstance());
+	std::lock_guard<std::mutex> lock(log->_mutex);
+
+	/* Another thread may have won the race */
+	Uint32 id(site.id.load(std::memory_order_acquire));
+	if (id)
+		return id;
+
+	log->_sites.push_back({ site.priority, site.category, format });
+	id = static_cast<Uint32>(log->_sites.size());
+	site.id.store(id, std::memory_order_release);
+
+	return id;
+}
+
+void FastLog::encode(Slot & slot, char const * value)
+{
+	if (!value)
+		value = "(null)";
+
+	std::size_t const length(std::min<std::size_t>(std::strlen(value),
+		FAST_LOG_STRING_MAX));
+	if (slot.size + 2 + length > sizeof(slot.payload))
+		return;
+
+	slot.payload[slot.size++] = static_cast<char>(STRING);
+	slot.payload[slot.size++] = static_cast<char>(length);
+	std::memcpy(slot.payload + slot.size, value, length);
+	slot.size += static_cast<Uint16>(length);
+}
+
+/* Producer side : never blocks, drops when the consumer lags behind */
+bool FastLog::push(Ring & ring, Slot const & slot)
+{
+	Uint32 const head(ring.head.load(std::memory_order_relaxed));
+
+	if (head - ring.tail.load(std::memory_order_acquire) >= FAST_LOG_RING_SLOTS)
+	{
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Slot & target(ring.slots[head % FAST_LOG_RING_SLOTS]);
+	std::memcpy(&target, &slot, offsetof(Slot, payload) + slot.size);
+	ring.head.store(head + 1, std::memory_order_release);
+
+	/* Pairs with the consumer's fence : it sees this entry, or we see it asleep */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_sleeping.load(std::memory_order_relaxed))
+		getInstance()->wakeConsumer();
+
+	return true;
+}
+
+void FastLog::wakeConsumer(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_sleeping.store(false, std::memory_order_relaxed);
+	}
+	_wake.notify_one();
+}
+
+bool FastLog::start(std::string const & path)
+{
+	stop();
+
+	if (!path.empty())
+	{
+		Uint32 const version(FAST_LOG_VERSION);
+		Uint64 const frequency(SDL_GetPerformanceFrequency());
+
+		_output.open(path, std::ios::binary | std::ios::trunc);
+		if (!_output)
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+				"Cannot write log to \"%s\"", path.c_str());
+			return false;
+		}
+
+		_output.write(FAST_LOG_MAGIC, 4);
+		_output.write(reinterpret_cast<char const *>(&version), sizeof(version));
+		_output.write(reinterpret_cast<char const *>(&frequency), sizeof(frequency));
+		_sitesWritten.clear();
+	}
+
+	_stopping = false;
+	_consumer = std::thread(&FastLog::consume, this);
+
+	return true;
+}
+
+void FastLog::stop(void)
+{
+	if (!_consumer.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+	_consumer.join();
+
+	if (_output.is_open())
+		_output.close();
+}
+
+void FastLog::consume(void)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (!_stopping)
+	{
+		_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (isEmpty())
+			_wake.wait(lock, [this]
+			{
+				return _stopping || !_sleeping.load(std::memory_order_relaxed);
+			});
+		_sleeping.store(false, std::memory_order_relaxed);
+
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
+
+	/* What was logged before stop() still goes out */
+	lock.unlock();
+	drain();
+}
+
+/* Under the lock : nothing to drain, no ring to free */
+bool FastLog::isEmpty(void)
+{
+	for (std::unique_ptr<Ring> const & ring : _rings)
+		if (ring->head.load(std::memory_order_relaxed)
+			!= ring->tail.load(std::memory_order_relaxed)
+			|| ring->dropped.load(std::memory_order_relaxed)
+			|| ring->exited.load(std::memory_order_relaxed))
+			return false;
+
+	return true;
+}
+
+void FastLog::drain(void)
+{
+	std::vector<Ring *> rings;
+	std::vector<Uint32> heads;
+	std::vector<Ring *> freed;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (std::unique_ptr<Ring> const & ring : _rings)
+			rings.push_back(ring.get());
+	}
+
+	for (Ring * ring : rings)
+	{
+		/* Read first : an exited thread's last entries are then all visible */
+		if (ring->exited.load(std::memory_order_acquire))
+			freed.push_back(ring);
+		heads.push_back(ring->head.load(std::memory_order_acquire));
+	}
+
+	/* Entries up to those heads only name sites registered before them */
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_drainedSites.insert(_drainedSites.end(),
+			_sites.begin() + _drainedSites.size(), _sites.end());
+	}
+
+	for (std::size_t index(0); index < rings.size(); ++index)
+	{
+		Ring * const ring(rings[index]);
+		Uint32 tail(ring->tail.load(std::memory_order_relaxed));
+		Uint32 const head(heads[index]);
+
+		for (; tail != head; ++tail)
+		{
+			Slot const & slot(ring->slots[tail % FAST_LOG_RING_SLOTS]);
+			SiteInfo const & site(_drainedSites[slot.site - 1]);
+
+			if (_output.is_open())
+				writeRecord(slot, site);
+			else
+				SDL_LogMessage(site.category, site.priority, "%s",
+					format(site.format, slot.payload, slot.size).c_str());
+		}
+		ring->tail.store(tail, std::memory_order_release);
+
+		Uint32 const dropped(ring->dropped.exchange(0, std::memory_order_relaxed));
+		if (!dropped)
+			continue;
+
+		if (_output.is_open())
+		{
+			Uint8 const kind(DROPPED);
+			_output.write(reinterpret_cast<char const *>(&kind), 1);
+			_output.write(reinterpret_cast<char const *>(&ring->thread), 4);
+			_output.write(reinterpret_cast<char const *>(&dropped), 4);
+		}
+		else
+			SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+				"%u log entries dropped by thread %u", dropped, ring->thread);
+	}
+
+	if (_output.is_open())
+		_output.flush();
+
+	/* Only the consumer removes rings : none of those is in use anymore */
+	if (!freed.empty())
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_rings.erase(std::remove_if(_rings.begin(), _rings.end(),
+			[&freed](std::unique_ptr<Ring> const & ring)
+			{
+				return std::find(freed.begin(), freed.end(), ring.get()) != freed.end();
+			}), _rings.end());
+	}
+}
+
+void FastLog::writeRecord(Slot const & slot, SiteInfo const & site)
+{
+	/* Each site's format goes out once, before its first entry */
+	if (_sitesWritten.size() < slot.site)
+		_sitesWritten.resize(slot.site, false);
+	if (!_sitesWritten[slot.site - 1])
+	{
+		Uint8 const kind(SITE);
+		Uint8 const priority(static_cast<Uint8>(site.priority));
+		Sint32 const category(site.category);
+		Uint16 const length(static_cast<Uint16>(std::strlen(site.format)));
+
+		_output.write(reinterpret_cast<char const *>(&kind), 1);
+		_output.write(reinterpret_cast<char const *>(&slot.site), 4);
+		_output.write(reinterpret_cast<char const *>(&priority), 1);
+		_output.write(reinterpret_cast<char const *>(&category), 4);
+		_output.write(reinterpret_cast<char const *>(&length), 2);
+		_output.write(site.format, length);
+		_sitesWritten[slot.site - 1] = true;
+	}
+
+	Uint8 const kind(ENTRY);
+	_output.write(reinterpret_cast<char const *>(&kind), 1);
+	_output.write(reinterpret_cast<char const *>(&slot.site), 4);
+	_output.write(reinterpret_cast<char const *>(&slot.time), 8);
+	_output.write(reinterpret_cast<char const *>(&slot.size), 2);
+	_output.write(slot.payload, slot.size);
+}
+
+/*
+ * printf, one conversion at a time : each specification gets the length
+ * modifier of the recorded argument's type, or that type's own conversion
+ * when the format asked for something else.
+ */
+std::string FastLog::format(char const * format,
+	char const * payload, std::size_t const size)
+{
+	std::string text;
+	std::size_t offset(0);
+	char buffer[128];
+
+	for (char const * c(format); *c; ++c)
+	{
+		if (*c != '%')
+		{
+			text += *c;
+			continue;
+		}
+		if (c[1] == '%')
+		{
+			text += '%';
+			++c;
+			continue;
+		}
+
+		/* Flags, width & precision are kept, length modifiers dropped */
+		std::string spec("%");
+		for (++c; *c && std::strchr("-+ #0123456789.", *c); ++c)
+			spec += *c;
+		while (*c && std::strchr("hljztL", *c))
+			++c;
+		if (!*c)
+			break;
+		char conversion(*c);
+
+		if (offset >= size)
+		{
+			text += "<missing>";
+			continue;
+		}
+
+		Tag const tag(static_cast<Tag>(payload[offset++]));
+		bool const integer(std::strchr("diouxXc", conversion) != nullptr);
+		bool const real(std::strchr("eEfFgGaA", conversion) != nullptr);
+		int written(0);
+
+		/* Size of the argument's value, string lengths included */
+		std::size_t needed(8);
+		if (tag == INT32 || tag == UINT32)
+			needed = 4;
+		else if (tag == STRING)
+			needed = (offset < size)
+				? 1 + static_cast<unsigned char>(payload[offset]) : 1;
+		else if (tag < INT32 || tag > POINTER)
+			needed = 0;
+		if (offset + needed > size)
+		{
+			text += "<truncated>";
+			return text;
+		}
+
+		switch (tag)
+		{
+			case INT32:
+			case UINT32:
+			{
+				Uint32 value;
+				std::memcpy(&value, payload + offset, 4);
+				offset += 4;
+				if (!integer)
+					conversion = (tag == INT32) ? 'd' : 'u';
+				written = std::snprintf(buffer, sizeof(buffer),
+					(spec + conversion).c_str(), value);
+			}
+			break;
+
+			case INT64:
+			case UINT64:
+			{
+				Uint64 value;
+				std::memcpy(&value, payload + offset, 8);
+				offset += 8;
+				if (!integer || conversion == 'c')
+					conversion = (tag == INT64) ? 'd' : 'u';
+				written = std::snprintf(buffer, sizeof(buffer),
+					(spec + "ll" + conversion).c_str(), value);
+			}
+			break;
+
+			case DOUBLE:
+			{
+				double value;
+				std::memcpy(&value, payload + offset, 8);
+				offset += 8;
+				if (!real)
+					conversion = 'f';
+				written = std::snprintf(buffer, sizeof(buffer),
+					(spec + conversion).c_str(), value);
+			}
+			break;
+
+			case STRING:
+			{
+				std::size_t const length(static_cast<unsigned char>(payload[offset++]));
+				std::string const value(payload + offset, length);
+				offset += length;
+				written = std::snprintf(buffer, sizeof(buffer),
+					(spec + 's').c_str(), value.c_str());
+			}
+			break;
+
+			case POINTER:
+			{
+				Uint64 value;
+				std::memcpy(&value, payload + offset, 8);
+				offset += 8;
+				written = std::snprintf(buffer, sizeof(buffer), "%p",
+					reinterpret_cast<void *>(static_cast<uintptr_t>(value)));
+			}
+			break;
+
+			default:
+				text += "<corrupted>";
+				return text;
+		}
+
+		if (written > 0)
+			text.append(buffer, std::min<std::size_t>(written, sizeof(buffer) - 1));
+	}
+
+	return text;
+}
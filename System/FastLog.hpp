@@ -0,0 +1,264 @@
+#ifndef FAST_LOG_HPP_INCLUDED
+#define FAST_LOG_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define FAST_LOG_MAGIC "OPFL"
+#define FAST_LOG_VERSION 1
+
+/* Per-thread ring : a full ring drops (and counts) new entries */
+#define FAST_LOG_RING_SLOTS 1024
+#define FAST_LOG_SLOT_SIZE 128
+#define FAST_LOG_STRING_MAX 48
+
+/* Calls below this priority are compiled out */
+#ifndef FAST_LOG_MIN_PRIORITY
+#ifdef NDEBUG
+#define FAST_LOG_MIN_PRIORITY SDL_LOG_PRIORITY_DEBUG
+#else
+#define FAST_LOG_MIN_PRIORITY SDL_LOG_PRIORITY_VERBOSE
+#endif
+#endif
+
+/*
+ * Arguments are only evaluated above both the compile-time floor and the
+ * runtime threshold. The format string must be a literal : only its site
+ * id travels with the entry.
+ */
+#define FAST_LOG(priority, category, ...) \
+	do \
+	{ \
+		if ((priority) >= FAST_LOG_MIN_PRIORITY && FastLog::isEnabled(priority)) \
+		{ \
+			static FastLog::Site fastLogSite((priority), (category)); \
+			FastLog::write(fastLogSite, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define FAST_VERBOSE(category, ...) \
+	FAST_LOG(SDL_LOG_PRIORITY_VERBOSE, category, __VA_ARGS__)
+#define FAST_DEBUG(category, ...) \
+	FAST_LOG(SDL_LOG_PRIORITY_DEBUG, category, __VA_ARGS__)
+#define FAST_INFO(category, ...) \
+	FAST_LOG(SDL_LOG_PRIORITY_INFO, category, __VA_ARGS__)
+
+/*
+ * Logging without formatting on the calling thread. A call writes its site
+ * id, a timestamp & its raw arguments (tagged by type) into the calling
+ * thread's lock-free single-producer ring. A background consumer drains the
+ * rings and either formats entries into SDL's log (hence the log overlay),
+ * or writes them as binary records, formatted offline by
+ * Tools/LogDecoder.cpp. It sleeps while every ring is empty : only the push
+ * that ends such a sleep takes its lock, to wake it up.
+ *
+ * Binary file layout, native byte order : 4-byte magic, Uint32 version,
+ * Uint64 performance counter frequency, then records made of a Uint8 kind :
+ * - SITE : Uint32 id, Uint8 priority, Sint32 category, Uint16 length, format
+ * - ENTRY : Uint32 site, Uint64 time, Uint16 size, tagged arguments
+ * - DROPPED : Uint32 thread, Uint32 entries lost to a full ring
+ */
+class FastLog
+{
+	public:
+		enum RecordKind
+		{
+			SITE = 1,
+			ENTRY = 2,
+			DROPPED = 3
+		};
+
+		enum Tag
+		{
+			INT32 = 1,
+			UINT32,
+			INT64,
+			UINT64,
+			DOUBLE,
+			STRING,
+			POINTER
+		};
+
+		/* One per call site, registered on first use */
+		struct Site
+		{
+			SDL_LogPriority const priority;
+			int const category;
+			std::atomic<Uint32> id;
+
+			constexpr Site(SDL_LogPriority const p, int const c) :
+				priority(p), category(c), id(0)
+			{}
+		};
+
+		struct Slot
+		{
+			Uint32 site;
+			Uint16 size;
+			Uint16 reserved;
+			Uint64 time;
+			char payload[FAST_LOG_SLOT_SIZE - 16];
+		};
+
+	private:
+		struct Ring
+		{
+			std::array<Slot, FAST_LOG_RING_SLOTS> slots;
+			std::atomic<Uint32> head;
+			std::atomic<Uint32> tail;
+			std::atomic<Uint32> dropped;
+			Uint32 thread;
+
+			/* Set as its thread exits : freed once drained */
+			std::atomic<bool> exited;
+		};
+
+		/* Thread-local handle, flagging the ring as its thread exits */
+		struct RingOwner
+		{
+			Ring * ring;
+
+			~RingOwner(void)
+			{
+				if (ring)
+					ring->exited.store(true, std::memory_order_release);
+			}
+		};
+
+		struct SiteInfo
+		{
+			SDL_LogPriority priority;
+			int category;
+			char const * format;
+		};
+
+		static std::atomic<int> _threshold;
+		static std::atomic<bool> _sleeping;
+
+		std::mutex _mutex;
+		std::vector<std::unique_ptr<Ring>> _rings;
+		std::vector<SiteInfo> _sites;
+
+		std::thread _consumer;
+		std::condition_variable _wake;
+		bool _stopping;
+		std::ofstream _output;
+		std::vector<bool> _sitesWritten;
+
+		/* Consumer's copy of _sites, extended by the sites added since */
+		std::vector<SiteInfo> _drainedSites;
+
+		FastLog(void);
+
+		static Ring & getRing(void);
+		static Uint32 registerSite(Site & site, char const * format);
+
+		/* Argument encoding : one tag byte, then the raw value */
+		template<typename T>
+		static void put(Slot & slot, Tag const tag, T const value)
+		{
+			if (slot.size + 1 + sizeof(T) > sizeof(slot.payload))
+				return;
+			slot.payload[slot.size++] = static_cast<char>(tag);
+			std::memcpy(slot.payload + slot.size, &value, sizeof(T));
+			slot.size += sizeof(T);
+		}
+
+		static void encode(Slot & slot, char const * value);
+		static void encode(Slot & slot, std::string const & value)
+		{
+			encode(slot, value.c_str());
+		}
+		static void encode(Slot & slot, double const value)
+		{
+			put(slot, DOUBLE, value);
+		}
+		static void encode(Slot & slot, void const * value)
+		{
+			put(slot, POINTER, static_cast<Uint64>(reinterpret_cast<uintptr_t>(value)));
+		}
+		template<typename T>
+		static typename std::enable_if<std::is_integral<T>::value
+			|| std::is_enum<T>::value>::type
+		encode(Slot & slot, T const value)
+		{
+			if (std::is_signed<T>::value && sizeof(T) <= 4)
+				put(slot, INT32, static_cast<Sint32>(value));
+			else if (sizeof(T) <= 4)
+				put(slot, UINT32, static_cast<Uint32>(value));
+			else if (std::is_signed<T>::value)
+				put(slot, INT64, static_cast<Sint64>(value));
+			else
+				put(slot, UINT64, static_cast<Uint64>(value));
+		}
+		static void encode(Slot & slot, float const value)
+		{
+			put(slot, DOUBLE, static_cast<double>(value));
+		}
+
+		static void encodeAll(Slot &)
+		{}
+		template<typename T, typename ... Rest>
+		static void encodeAll(Slot & slot, T const & value, Rest const & ... rest)
+		{
+			encode(slot, value);
+			encodeAll(slot, rest...);
+		}
+
+		static bool push(Ring & ring, Slot const & slot);
+		void wakeConsumer(void);
+
+		void consume(void);
+		bool isEmpty(void);
+		void drain(void);
+		void writeRecord(Slot const & slot, SiteInfo const & site);
+
+	public:
+		static std::shared_ptr<FastLog> getInstance(void);
+		~FastLog(void);
+
+		static bool isEnabled(SDL_LogPriority const priority)
+		{
+			return priority >= _threshold.load(std::memory_order_relaxed);
+		}
+		static void setThreshold(SDL_LogPriority const priority);
+
+		template<typename ... Args>
+		static void write(Site & site, char const * format, Args const & ... args)
+		{
+			Slot slot;
+			Uint32 id(site.id.load(std::memory_order_acquire));
+
+			if (!id)
+				id = registerSite(site, format);
+
+			slot.site = id;
+			slot.size = 0;
+			slot.reserved = 0;
+			slot.time = SDL_GetPerformanceCounter();
+			encodeAll(slot, args...);
+
+			push(getRing(), slot);
+		}
+
+		/* Text output through SDL_Log, or binary records to <path> */
+		bool start(std::string const & path = std::string());
+		void stop(void);
+
+		/* Payloads may come from files : arguments cut short end the text */
+		static std::string format(char const * format,
+			char const * payload, std::size_t const size);
+};
+
+#endif // FAST_LOG_HPP_INCLUDED
@@ -0,0 +1,234 @@
+#include "FrameProfiler.hpp"
+#include "../Graphics/GlyphAtlas.hpp"
+#include "../Graphics/RendererAccess.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+/* Graph scale : the full graph height stands for two 60 Hz frames */
+#define GRAPH_HEIGHT 120
+#define GRAPH_RANGE_MS 33.3
+
+bool FrameProfiler::_enabled(false);
+
+FrameProfiler::FrameProfiler(void) :
+	_current{},
+	_history{},
+	_cursor(0),
+	_samples(0),
+	_frameStart(0),
+	_msPerCount(1000. / SDL_GetPerformanceFrequency())
+{}
+
+std::shared_ptr<FrameProfiler> FrameProfiler::getInstance(void)
+{
+	static std::shared_ptr<FrameProfiler> instance(new FrameProfiler);
+	return instance;
+}
+
+bool FrameProfiler::isEnabled(void)
+{
+	return _enabled;
+}
+
+void FrameProfiler::record(Stage const stage, Uint64 const counts)
+{
+	/* Raw pointer : no reference count traffic on the probe path */
+	static FrameProfiler * const instance(getInstance().get());
+	instance->_current[stage] += counts;
+}
+
+void FrameProfiler::setEnabled(bool const state)
+{
+	_enabled = state;
+
+	/* Start over, samples from before were not measured */
+	_current.fill(0);
+	_cursor = 0;
+	_samples = 0;
+	_frameStart = 0;
+}
+
+void FrameProfiler::toggle(void)
+{
+	setEnabled(!_enabled);
+}
+
+void FrameProfiler::endFrame(void)
+{
+	if (!_enabled)
+		return;
+
+	Uint64 const now(SDL_GetPerformanceCounter());
+
+	/* The first frame has no start : it only opens the window */
+	if (_frameStart)
+	{
+		_current[FRAME] = now - _frameStart;
+		for (unsigned int stage(0); stage < NB_STAGES; ++stage)
+			_history[stage][_cursor] = _current[stage];
+
+		_cursor = (_cursor + 1) % FRAME_PROFILER_HISTORY;
+		_samples = std::min(_samples + 1, static_cast<unsigned int>(FRAME_PROFILER_HISTORY));
+	}
+
+	_current.fill(0);
+	_frameStart = now;
+}
+
+unsigned int FrameProfiler::getSampleCount(void) const
+{
+	return _samples;
+}
+
+Uint64 FrameProfiler::getLastSample(Stage const stage) const
+{
+	if (!_samples)
+		return 0;
+
+	return _history[stage][(_cursor + FRAME_PROFILER_HISTORY - 1) % FRAME_PROFILER_HISTORY];
+}
+
+double FrameProfiler::getMillisecondsPerCount(void) const
+{
+	return _msPerCount;
+}
+
+FrameProfiler::Statistics FrameProfiler::getStatistics(Stage const stage) const
+{
+	Statistics statistics{ 0., 0., 0. };
+	std::array<Uint64, FRAME_PROFILER_HISTORY> sorted;
+	Uint64 sum(0);
+
+	if (!_samples)
+		return statistics;
+
+	std::copy(_history[stage].begin(), _history[stage].begin() + _samples, sorted.begin());
+	for (unsigned int i(0); i < _samples; ++i)
+		sum += sorted[i];
+
+	unsigned int const p99((_samples * 99) / 100);
+	std::nth_element(sorted.begin(), sorted.begin() + p99, sorted.begin() + _samples);
+
+	statistics.min = *std::min_element(sorted.begin(), sorted.begin() + _samples) * _msPerCount;
+	statistics.avg = (static_cast<double>(sum) / _samples) * _msPerCount;
+	statistics.p99 = sorted[p99] * _msPerCount;
+
+	return statistics;
+}
+
+char const * FrameProfiler::getStageName(Stage const stage)
+{
+	switch (stage)
+	{
+		case EVENTS: return "events";
+		case ELAPSE: return "elapse";
+		case DISPLAY: return "display";
+		case SUB_VIEW: return "sub-view";
+		case LOG_OVERLAY: return "log overlay";
+		case PRESENT: return "present";
+		case FRAME: return "frame";
+		default: return "?";
+	}
+}
+
+void FrameProfiler::display(Window * window, SDL_Rect const & area)
+{
+	SDL_Renderer * renderer(getSDLRenderer(window));
+	static SDL_Color const colors[NB_STAGES] = {
+		{ 255, 200, 0, 255 },	// events
+		{ 0, 200, 80, 255 },	// elapse
+		{ 0, 0, 0, 0 },		// display (sum of the three below)
+		{ 0, 150, 255, 255 },	// sub-view
+		{ 200, 0, 255, 255 },	// log overlay
+		{ 255, 60, 60, 255 },	// present
+		{ 90, 90, 90, 255 }	// frame (time outside any stage)
+	};
+	static Stage const stacked[] = { EVENTS, ELAPSE, SUB_VIEW, LOG_OVERLAY, PRESENT };
+	std::vector<SDL_Rect> bars[NB_STAGES];
+	std::vector<SDL_Rect> idle;
+	SDL_BlendMode blendMode;
+	SDL_Color drawColor;
+
+	if (!renderer)
+		return;
+
+	/* The view under the overlay draws with its own settings next frame */
+	SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+	SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g, &drawColor.b,
+		&drawColor.a);
+
+	/* Translucent backdrop */
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+	SDL_RenderFillRect(renderer, &area);
+
+	/* Stacked bars, oldest on the left, then the unaccounted frame time */
+	int const barWidth(std::max(area.w / FRAME_PROFILER_HISTORY, 1));
+	double const pixelsPerCount((GRAPH_HEIGHT / GRAPH_RANGE_MS) * _msPerCount);
+	int const baseline(area.y + GRAPH_HEIGHT);
+
+	for (unsigned int i(0); i < _samples; ++i)
+	{
+		unsigned int const slot((_cursor + FRAME_PROFILER_HISTORY - _samples + i)
+			% FRAME_PROFILER_HISTORY);
+		int const x(area.x + static_cast<int>(i) * barWidth);
+		int top(baseline);
+
+		for (Stage stage : stacked)
+		{
+			int const bottom(top);
+			top -= static_cast<int>(_history[stage][slot] * pixelsPerCount);
+
+			int const clippedTop(std::max(top, area.y));
+			if (clippedTop < bottom)
+				bars[stage].push_back({ x, clippedTop, barWidth, bottom - clippedTop });
+		}
+
+		int const frameTop(std::max(area.y, baseline
+			- static_cast<int>(_history[FRAME][slot] * pixelsPerCount)));
+		if (frameTop < top)
+			idle.push_back({ x, frameTop, barWidth, top - frameTop });
+	}
+
+	SDL_SetRenderDrawColor(renderer, colors[FRAME].r, colors[FRAME].g,
+		colors[FRAME].b, colors[FRAME].a);
+	if (!idle.empty())
+		SDL_RenderFillRects(renderer, idle.data(), static_cast<int>(idle.size()));
+
+	for (Stage stage : stacked)
+	{
+		if (bars[stage].empty())
+			continue;
+
+		SDL_SetRenderDrawColor(renderer, colors[stage].r, colors[stage].g,
+			colors[stage].b, colors[stage].a);
+		SDL_RenderFillRects(renderer, bars[stage].data(),
+			static_cast<int>(bars[stage].size()));
+	}
+
+	/* 60 Hz budget line */
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	SDL_RenderDrawLine(renderer, area.x, baseline - GRAPH_HEIGHT / 2,
+		area.x + area.w, baseline - GRAPH_HEIGHT / 2);
+
+	/* Rolling statistics */
+	char line[64];
+	std::string table("stage         min    avg    p99 (ms)");
+	for (unsigned int stage(0); stage < NB_STAGES; ++stage)
+	{
+		Statistics const statistics(getStatistics(static_cast<Stage>(stage)));
+		std::snprintf(line, sizeof(line), "\n%-12s %6.2f %6.2f %6.2f",
+			getStageName(static_cast<Stage>(stage)),
+			statistics.min, statistics.avg, statistics.p99);
+		table += line;
+	}
+
+	TextCache::getInstance()->printText(window, table, "courier", 12,
+		{ 255, 255, 255, 255 },
+		{ area.x + 4, baseline + 4, area.w - 8, area.h - GRAPH_HEIGHT - 8 });
+
+	SDL_SetRenderDrawBlendMode(renderer, blendMode);
+	SDL_SetRenderDrawColor(renderer, drawColor.r, drawColor.g, drawColor.b,
+		drawColor.a);
+}
@@ -0,0 +1,91 @@
+#ifndef FRAME_PROFILER_HPP_INCLUDED
+#define FRAME_PROFILER_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <memory>
+#include <string>
+
+#define FRAME_PROFILER_HISTORY 128
+
+class Window;
+
+/*
+ * Per-frame stage timings over a rolling window of frames. Probes only read
+ * the performance counter while the profiler is enabled, so when the graph
+ * is hidden each probe costs one predictable branch.
+ */
+class FrameProfiler
+{
+	public:
+		enum Stage
+		{
+			EVENTS,
+			ELAPSE,
+			DISPLAY,
+			SUB_VIEW,
+			LOG_OVERLAY,
+			PRESENT,
+			FRAME,
+			NB_STAGES
+		};
+
+		struct Statistics
+		{
+			double min;
+			double avg;
+			double p99;
+		};
+
+		class Probe
+		{
+			private:
+				Stage const _stage;
+				Uint64 const _start;
+
+			public:
+				Probe(Stage const stage) :
+					_stage(stage),
+					_start(FrameProfiler::_enabled ? SDL_GetPerformanceCounter() : 0)
+				{}
+
+				~Probe(void)
+				{
+					if (_start)
+						FrameProfiler::record(_stage,
+							SDL_GetPerformanceCounter() - _start);
+				}
+		};
+
+	private:
+		static bool _enabled;
+
+		std::array<Uint64, NB_STAGES> _current;
+		std::array<std::array<Uint64, FRAME_PROFILER_HISTORY>, NB_STAGES> _history;
+		unsigned int _cursor;
+		unsigned int _samples;
+		Uint64 _frameStart;
+		double _msPerCount;
+
+		FrameProfiler(void);
+
+	public:
+		static std::shared_ptr<FrameProfiler> getInstance(void);
+
+		static bool isEnabled(void);
+		static void record(Stage const stage, Uint64 const counts);
+
+		void setEnabled(bool const state);
+		void toggle(void);
+		void endFrame(void);
+
+		unsigned int getSampleCount(void) const;
+		Uint64 getLastSample(Stage const stage) const;
+		double getMillisecondsPerCount(void) const;
+		Statistics getStatistics(Stage const stage) const;
+		static char const * getStageName(Stage const stage);
+
+		void display(Window * window, SDL_Rect const & area);
+};
+
+#endif // FRAME_PROFILER_HPP_INCLUDED
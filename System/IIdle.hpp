@@ -0,0 +1,24 @@
+#ifndef I_IDLE_HPP_INCLUDED
+#define I_IDLE_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+
+/* Idle time meaning "nothing changes until the next input event" */
+#define IDLE_FOREVER 0xFFFFFFFFu
+
+/*
+ * Implemented by models and views able to tell when they next change on
+ * their own. While every part of a context is idle and no event came in,
+ * GameContext neither displays nor presents, and blocks on the event queue
+ * until the earliest deadline instead.
+ */
+class IIdle
+{
+	public:
+		virtual ~IIdle(void) {}
+
+		/* Milliseconds before the next spontaneous change, 0 if busy */
+		virtual Uint32 getIdleTime(void) const = 0;
+};
+
+#endif // I_IDLE_HPP_INCLUDED
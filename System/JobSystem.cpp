@@ -0,0 +1,255 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+std::size_t JobSystem::Graph::add(Task task,
+	std::vector<std::size_t> const & dependencies)
+{
+	std::size_t const index(_nodes.size());
+
+	_nodes.emplace_back();
+	_nodes.back().task = task;
+	_nodes.back().dependencies = static_cast<int>(dependencies.size());
+	_nodes.back().waiting = 0;
+
+	/* Only earlier nodes can be depended on : no cycle is possible */
+	for (std::size_t dependency : dependencies)
+		_nodes.at(dependency).successors.push_back(index);
+
+	return index;
+}
+
+void JobSystem::Graph::run(void)
+{
+	std::shared_ptr<JobSystem> jobs(JobSystem::getInstance());
+	Counter counter;
+
+	for (Node & node : _nodes)
+		node.waiting.store(node.dependencies, std::memory_order_relaxed);
+
+	for (std::size_t node(0); node < _nodes.size(); ++node)
+		if (!_nodes[node].dependencies)
+			jobs->release(*this, node, counter);
+
+	jobs->wait(counter);
+}
+
+std::size_t JobSystem::Graph::getSize(void) const
+{
+	return _nodes.size();
+}
+
+JobSystem::JobSystem(void) :
+	_started(false),
+	_stopping(false),
+	_queued(0)
+{
+	_queues.emplace_back(new Queue);
+}
+
+JobSystem::~JobSystem(void)
+{
+	stop();
+}
+
+std::shared_ptr<JobSystem> JobSystem::getInstance(void)
+{
+	static std::shared_ptr<JobSystem> instance(new JobSystem);
+	return instance;
+}
+
+unsigned int JobSystem::getDefaultWorkers(void)
+{
+	return static_cast<unsigned int>(std::max(1, SDL_GetCPUCount() - 1));
+}
+
+/* Queue 0 unless the calling thread is a worker */
+std::size_t & JobSystem::getThreadQueue(void)
+{
+	static thread_local std::size_t queue(0);
+	return queue;
+}
+
+void JobSystem::start(unsigned int const workers)
+{
+	stop();
+
+	/* Queue 0 keeps what the previous workers left */
+	_queues.resize(1);
+	for (unsigned int worker(0); worker < workers; ++worker)
+		_queues.emplace_back(new Queue);
+
+	_stopping = false;
+	for (unsigned int worker(0); worker < workers; ++worker)
+		_workers.emplace_back(&JobSystem::work, this, worker + 1);
+	_started.store(true, std::memory_order_release);
+}
+
+void JobSystem::stop(void)
+{
+	_started.store(false, std::memory_order_release);
+	if (_workers.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+	for (std::thread & worker : _workers)
+		worker.join();
+	_workers.clear();
+
+	/* Whatever is left runs on the threads waiting for it */
+	for (std::size_t queue(1); queue < _queues.size(); ++queue)
+	{
+		std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+		_queues[0]->jobs.insert(_queues[0]->jobs.end(),
+			_queues[queue]->jobs.begin(), _queues[queue]->jobs.end());
+		_queues[queue]->jobs.clear();
+	}
+}
+
+unsigned int JobSystem::getThreads(void) const
+{
+	return static_cast<unsigned int>(_workers.size() + 1);
+}
+
+void JobSystem::push(Job const & job)
+{
+	Queue & queue(*_queues[std::min(getThreadQueue(), _queues.size() - 1)]);
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+	/* Counted under the sleepers' lock : none can miss the wake-up */
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_queued.fetch_add(1, std::memory_order_release);
+	}
+	if (!_workers.empty())
+		_wake.notify_one();
+}
+
+/* Newest of our own first, while it is still in cache ; oldest of others' */
+bool JobSystem::pop(Job & job)
+{
+	std::size_t const own(std::min(getThreadQueue(), _queues.size() - 1));
+
+	for (std::size_t offset(0); offset < _queues.size(); ++offset)
+	{
+		Queue & queue(*_queues[(own + offset) % _queues.size()]);
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.jobs.empty())
+			continue;
+
+		if (!offset)
+		{
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+		}
+		_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::runOne(void)
+{
+	Job job;
+
+	if (!pop(job))
+		return false;
+
+	job.task();
+	if (job.counter)
+		job.counter->_pending.fetch_sub(1, std::memory_order_release);
+
+	return true;
+}
+
+void JobSystem::work(std::size_t const queue)
+{
+	getThreadQueue() = queue;
+
+	for (;;)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_sleepMutex);
+			if (_stopping)
+				return;
+		}
+		if (runOne())
+			continue;
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_wake.wait(lock,
+			[this] { return _stopping || _queued.load(std::memory_order_acquire) > 0; });
+	}
+}
+
+void JobSystem::run(Task task, Counter & counter)
+{
+	if (!_started.load(std::memory_order_acquire))
+		start(getDefaultWorkers());
+
+	counter._pending.fetch_add(1, std::memory_order_relaxed);
+	push({ task, &counter });
+}
+
+void JobSystem::wait(Counter & counter)
+{
+	while (!counter.isDone())
+		if (!runOne())
+			std::this_thread::yield();
+}
+
+void JobSystem::parallelFor(std::size_t const count, std::size_t const grain,
+	Range body)
+{
+	std::size_t const chunk(std::max<std::size_t>(grain, 1));
+	Counter counter;
+
+	if (!count)
+		return;
+
+	/* The first chunk is ours : the others are queued before starting it */
+	for (std::size_t first(chunk); first < count; first += chunk)
+	{
+		std::size_t const last(std::min(first + chunk, count));
+		run([&body, first, last] { body(first, last); }, counter);
+	}
+
+	body(0, std::min(chunk, count));
+	wait(counter);
+}
+
+/* A job finishing releases the successors it was the last dependency of */
+void JobSystem::release(Graph & graph, std::size_t const node, Counter & counter)
+{
+	run([this, &graph, node, &counter]
+	{
+		graph._nodes[node].task();
+
+		for (std::size_t successor : graph._nodes[node].successors)
+			if (graph._nodes[successor].waiting.fetch_sub(1,
+				std::memory_order_acq_rel) == 1)
+				release(graph, successor, counter);
+	}, counter);
+}
+
+void JobSystem::schedule(Task task)
+{
+	run(task, _frame);
+}
+
+void JobSystem::joinFrame(void)
+{
+	wait(_frame);
+}
@@ -0,0 +1,149 @@
+#ifndef JOB_SYSTEM_HPP_INCLUDED
+#define JOB_SYSTEM_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Work-stealing thread pool for model updates. Each thread owns a job
+ * queue : it pushes & pops at the back of its own, and when that runs dry,
+ * steals from the front of the others'. Threads outside the pool, the main
+ * one among them, share queue 0. Idle workers sleep until a job is pushed.
+ *
+ * Unless start() sized it, the pool comes up with getDefaultWorkers() on
+ * the first job, from the main thread : activities that never ask for
+ * parallel work never have workers.
+ *
+ * Every API call joins what it started before returning, and a thread
+ * waiting for jobs runs queued ones meanwhile, so jobs may start jobs of
+ * their own. Jobs given to schedule() are joined by joinFrame(), which
+ * GameContext calls after each model elapse : nothing a model started is
+ * still running when its view displays.
+ *
+ * Splits depend on counts & grains only, never on the number of threads,
+ * so a job's results are the same whatever the pool's size.
+ */
+class JobSystem
+{
+	public:
+		typedef std::function<void(void)> Task;
+		typedef std::function<void(std::size_t first, std::size_t last)> Range;
+
+		/* Jobs left to finish : waited on by wait() */
+		class Counter
+		{
+			friend class JobSystem;
+
+			private:
+				std::atomic<int> _pending;
+
+			public:
+				Counter(void) : _pending(0)
+				{}
+				bool isDone(void) const
+				{
+					return !_pending.load(std::memory_order_acquire);
+				}
+		};
+
+		/*
+		 * Tasks run once all the tasks they depend on are done ; run() joins
+		 * the whole graph. A graph can be run again.
+		 */
+		class Graph
+		{
+			friend class JobSystem;
+
+			private:
+				struct Node
+				{
+					Task task;
+					std::vector<std::size_t> successors;
+					int dependencies;
+					std::atomic<int> waiting;
+				};
+
+				std::deque<Node> _nodes;
+
+			public:
+				std::size_t add(Task task,
+					std::vector<std::size_t> const & dependencies
+						= std::vector<std::size_t>());
+				void run(void);
+				std::size_t getSize(void) const;
+		};
+
+	private:
+		struct Job
+		{
+			Task task;
+			Counter * counter;
+		};
+
+		/* Own line each, threads hammer their own queue's lock */
+		struct alignas(64) Queue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		std::vector<std::unique_ptr<Queue>> _queues;
+		std::vector<std::thread> _workers;
+		std::atomic<bool> _started;
+		bool _stopping;
+
+		std::mutex _sleepMutex;
+		std::condition_variable _wake;
+		std::atomic<int> _queued;
+
+		Counter _frame;
+
+		JobSystem(void);
+
+		static std::size_t & getThreadQueue(void);
+
+		void push(Job const & job);
+		bool pop(Job & job);
+		bool runOne(void);
+		void work(std::size_t const queue);
+
+		void release(Graph & graph, std::size_t const node, Counter & counter);
+
+	public:
+		static std::shared_ptr<JobSystem> getInstance(void);
+		~JobSystem(void);
+
+		/* One worker per core but the calling thread's, at least one */
+		static unsigned int getDefaultWorkers(void);
+
+		/*
+		 * Restarting resizes the pool : no job may be running. Once
+		 * stopped, the next job starts the default pool again.
+		 */
+		void start(unsigned int const workers);
+		void stop(void);
+
+		/* Threads working on jobs, the calling one included */
+		unsigned int getThreads(void) const;
+
+		void run(Task task, Counter & counter);
+		void wait(Counter & counter);
+
+		/* [0, count) in chunks of <grain> iterations, joined on return */
+		void parallelFor(std::size_t const count, std::size_t const grain,
+			Range body);
+
+		/* Fire & forget, until the next joinFrame() */
+		void schedule(Task task);
+		void joinFrame(void);
+};
+
+#endif // JOB_SYSTEM_HPP_INCLUDED
@@ -0,0 +1,87 @@
+#include "LogRing.hpp"
+
+LogRing::LogRing(void) :
+	_lines(LOG_RING_CAPACITY),
+	_lastSequence(0),
+	_nextOutput(nullptr),
+	_nextUserData(nullptr)
+{}
+
+std::shared_ptr<LogRing> LogRing::getInstance(void)
+{
+	static std::shared_ptr<LogRing> instance(new LogRing);
+	return instance;
+}
+
+void LogRing::install(void)
+{
+	SDL_LogOutputFunction current(nullptr);
+	void * userData(nullptr);
+
+	/* Idempotent : only chain if someone replaced us since last time */
+	SDL_LogGetOutputFunction(&current, &userData);
+	if (current == &LogRing::output)
+		return;
+
+	_nextOutput = current;
+	_nextUserData = userData;
+	SDL_LogSetOutputFunction(&LogRing::output, this);
+}
+
+void LogRing::output(void * userData,
+	int category,
+	SDL_LogPriority priority,
+	char const * message)
+{
+	LogRing * ring(static_cast<LogRing *>(userData));
+
+	ring->append(message);
+	if (ring->_nextOutput)
+		ring->_nextOutput(ring->_nextUserData, category, priority, message);
+}
+
+void LogRing::append(std::string const & message)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::size_t begin(0);
+
+	/* One ring slot per displayed line */
+	do
+	{
+		std::size_t end(message.find('\n', begin));
+		if (end == std::string::npos)
+			end = message.size();
+
+		++_lastSequence;
+		_lines[_lastSequence % LOG_RING_CAPACITY].assign(message, begin, end - begin);
+		begin = end + 1;
+	}
+	while (begin < message.size());
+}
+
+Uint64 LogRing::getLastSequence(void) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _lastSequence;
+}
+
+Uint64 LogRing::getFirstSequence(void) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_lastSequence < LOG_RING_CAPACITY)
+		return 1;
+	return _lastSequence - LOG_RING_CAPACITY + 1;
+}
+
+bool LogRing::getLine(Uint64 const sequence, std::string & line) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (sequence == 0 || sequence > _lastSequence
+		|| sequence + LOG_RING_CAPACITY <= _lastSequence)
+		return false;
+
+	line = _lines[sequence % LOG_RING_CAPACITY];
+	return true;
+}
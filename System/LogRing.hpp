@@ -0,0 +1,46 @@
+#ifndef LOG_RING_HPP_INCLUDED
+#define LOG_RING_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define LOG_RING_CAPACITY 256
+
+/*
+ * Fixed-capacity ring of the most recent log lines, fed by chaining onto
+ * SDL's log output function. Every line gets a monotonically increasing
+ * sequence number (starting at 1) so readers can ask for "everything since
+ * the last line I drew" without copying the whole log.
+ */
+class LogRing
+{
+	private:
+		mutable std::mutex _mutex;
+		std::vector<std::string> _lines;
+		Uint64 _lastSequence;
+
+		SDL_LogOutputFunction _nextOutput;
+		void * _nextUserData;
+
+		LogRing(void);
+
+		static void output(void * userData,
+			int category,
+			SDL_LogPriority priority,
+			char const * message);
+
+	public:
+		static std::shared_ptr<LogRing> getInstance(void);
+
+		void install(void);
+		void append(std::string const & message);
+
+		Uint64 getLastSequence(void) const;
+		Uint64 getFirstSequence(void) const;
+		bool getLine(Uint64 const sequence, std::string & line) const;
+};
+
+#endif // LOG_RING_HPP_INCLUDED
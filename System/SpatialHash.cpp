@@ -0,0 +1,214 @@
+#include "SpatialHash.hpp"
+#include <algorithm>
+#include <cmath>
+
+/* Cell coordinates are clamped there, far beyond any sensible world */
+#define SPATIAL_HASH_CELL_LIMIT (Sint64(1) << 40)
+
+SpatialHash::SpatialHash(double const cellSize, std::size_t const buckets) :
+	_inverseCellSize(1. / cellSize),
+	_minimumBuckets(buckets),
+	_mask(static_cast<Uint32>(buckets - 1)),
+	_starts(buckets + 1, 0),
+	_generation(0)
+{}
+
+Uint32 SpatialHash::getBucket(Sint64 const cellX, Sint64 const cellY) const
+{
+	return ((static_cast<Uint32>(cellX) * 73856093u)
+		^ (static_cast<Uint32>(cellY) * 19349663u)) & _mask;
+}
+
+Sint64 SpatialHash::getCell(double const coordinate) const
+{
+	double const cell(std::floor(coordinate * _inverseCellSize));
+
+	if (!(cell > -SPATIAL_HASH_CELL_LIMIT))
+		return -SPATIAL_HASH_CELL_LIMIT;
+	if (cell > SPATIAL_HASH_CELL_LIMIT)
+		return SPATIAL_HASH_CELL_LIMIT;
+	return static_cast<Sint64>(cell);
+}
+
+bool SpatialHash::overlap(Box const & a, Box const & b)
+{
+	return a.minX <= b.maxX && b.minX <= a.maxX
+		&& a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+void SpatialHash::build(std::vector<Box> const & boxes)
+{
+	/* About one bucket per box keeps buckets short as the count grows */
+	std::size_t buckets(_minimumBuckets);
+	while (buckets < boxes.size() && buckets < SPATIAL_HASH_MAX_BUCKETS)
+		buckets *= 2;
+	if (buckets != _starts.size() - 1)
+	{
+		_starts.assign(buckets + 1, 0);
+		_mask = static_cast<Uint32>(buckets - 1);
+	}
+
+	Uint32 const count(static_cast<Uint32>(boxes.size()));
+
+	_boxes = boxes;
+	_boxBuckets.resize(boxes.size() * SPATIAL_HASH_MAX_CELLS);
+	_boxBucketCounts.assign(boxes.size(), 0);
+	_oversized.clear();
+	std::fill(_starts.begin(), _starts.end(), 0);
+
+	/* Count each box once per distinct bucket it overlaps */
+	for (Uint32 index(0); index < count; ++index)
+	{
+		Box const & box(_boxes[index]);
+		Sint64 const firstX(getCell(box.minX)), lastX(getCell(box.maxX));
+		Sint64 const firstY(getCell(box.minY)), lastY(getCell(box.maxY));
+
+		if (lastX - firstX >= SPATIAL_HASH_MAX_CELLS
+			|| lastY - firstY >= SPATIAL_HASH_MAX_CELLS
+			|| (lastX - firstX + 1) * (lastY - firstY + 1) > SPATIAL_HASH_MAX_CELLS)
+		{
+			_oversized.push_back(index);
+			continue;
+		}
+
+		Uint32 * const list(&_boxBuckets[index * SPATIAL_HASH_MAX_CELLS]);
+		Uint8 & listed(_boxBucketCounts[index]);
+
+		for (Sint64 cellY(firstY); cellY <= lastY; ++cellY)
+			for (Sint64 cellX(firstX); cellX <= lastX; ++cellX)
+			{
+				Uint32 const bucket(getBucket(cellX, cellY));
+				if (std::find(list, list + listed, bucket) != list + listed)
+					continue;
+				list[listed++] = bucket;
+				++_starts[bucket];
+			}
+	}
+
+	/* Bucket ends, then filled backwards down to each bucket's start */
+	for (std::size_t bucket(1); bucket < buckets; ++bucket)
+		_starts[bucket] += _starts[bucket - 1];
+	_starts[buckets] = buckets ? _starts[buckets - 1] : 0;
+	_entries.resize(_starts[buckets]);
+
+	for (Uint32 index(count); index--;)
+	{
+		Uint32 const * const list(&_boxBuckets[index * SPATIAL_HASH_MAX_CELLS]);
+		for (Uint8 entry(0); entry < _boxBucketCounts[index]; ++entry)
+			_entries[--_starts[list[entry]]] = index;
+	}
+
+	_marks.assign(boxes.size(), 0);
+	_generation = 0;
+}
+
+void SpatialHash::clear(void)
+{
+	build(std::vector<Box>());
+}
+
+/*
+ * Two boxes sharing several cells meet in several buckets : a pair only
+ * counts in the bucket of the cell holding its overlap's min corner, which
+ * both boxes cover.
+ */
+void SpatialHash::findPairs(std::vector<Pair> & pairs) const
+{
+	pairs.clear();
+
+	for (std::size_t bucket(0); bucket + 1 < _starts.size(); ++bucket)
+	{
+		Uint32 const end(_starts[bucket + 1]);
+
+		for (Uint32 first(_starts[bucket]); first < end; ++first)
+		{
+			Box const & a(_boxes[_entries[first]]);
+
+			for (Uint32 second(first + 1); second < end; ++second)
+			{
+				Box const & b(_boxes[_entries[second]]);
+				if (!overlap(a, b))
+					continue;
+
+				if (getBucket(getCell(std::max(a.minX, b.minX)),
+					getCell(std::max(a.minY, b.minY))) == bucket)
+					pairs.push_back({ _entries[first], _entries[second] });
+			}
+		}
+	}
+
+	for (Uint32 oversized : _oversized)
+		for (Uint32 index(0); index < _boxes.size(); ++index)
+		{
+			/* Two oversized boxes : only from the lower one */
+			if (index == oversized
+				|| (!_boxBucketCounts[index] && index < oversized))
+				continue;
+
+			if (overlap(_boxes[oversized], _boxes[index]))
+				pairs.push_back({ std::min(oversized, index),
+					std::max(oversized, index) });
+		}
+}
+
+void SpatialHash::query(Box const & box, std::vector<Uint32> & found)
+{
+	found.clear();
+
+	if (!++_generation)
+	{
+		std::fill(_marks.begin(), _marks.end(), 0);
+		_generation = 1;
+	}
+
+	Sint64 const firstX(getCell(box.minX)), lastX(getCell(box.maxX));
+	Sint64 const firstY(getCell(box.minY)), lastY(getCell(box.maxY));
+
+	/* Over more cells than there are buckets, every bucket is visited anyway */
+	Sint64 const buckets(static_cast<Sint64>(_starts.size() - 1));
+	if (lastX - firstX >= buckets || lastY - firstY >= buckets
+		|| (lastX - firstX + 1) * (lastY - firstY + 1) > buckets)
+	{
+		for (Uint32 index(0); index < _boxes.size(); ++index)
+			if (overlap(box, _boxes[index]))
+				found.push_back(index);
+		return;
+	}
+
+	for (Sint64 cellY(firstY); cellY <= lastY; ++cellY)
+		for (Sint64 cellX(firstX); cellX <= lastX; ++cellX)
+		{
+			Uint32 const bucket(getBucket(cellX, cellY));
+
+			for (Uint32 entry(_starts[bucket]); entry < _starts[bucket + 1]; ++entry)
+			{
+				Uint32 const index(_entries[entry]);
+				if (_marks[index] == _generation || !overlap(box, _boxes[index]))
+					continue;
+				_marks[index] = _generation;
+				found.push_back(index);
+			}
+		}
+
+	for (Uint32 oversized : _oversized)
+		if (overlap(box, _boxes[oversized]))
+			found.push_back(oversized);
+}
+
+std::size_t SpatialHash::getSize(void) const
+{
+	return _boxes.size();
+}
+
+std::size_t SpatialHash::getOversized(void) const
+{
+	return _oversized.size();
+}
+
+std::size_t SpatialHash::getMemoryUsage(void) const
+{
+	return _boxes.capacity() * sizeof(Box)
+		+ (_starts.capacity() + _entries.capacity() + _oversized.capacity()
+			+ _boxBuckets.capacity() + _marks.capacity()) * sizeof(Uint32)
+		+ _boxBucketCounts.capacity() * sizeof(Uint8);
+}
@@ -0,0 +1,89 @@
+#ifndef SPATIAL_HASH_HPP_INCLUDED
+#define SPATIAL_HASH_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ * Bucket count : at least the one given (a power of 2, by default 4096),
+ * grown to the number of boxes up to the maximum
+ */
+#define SPATIAL_HASH_BUCKETS 4096
+#define SPATIAL_HASH_MAX_BUCKETS (1 << 20)
+
+/* Boxes covering more cells than this are checked against every box */
+#define SPATIAL_HASH_MAX_CELLS 16
+
+/*
+ * Broadphase over a uniform grid whose cells are hashed into a fixed number
+ * of buckets, rebuilt from scratch by build() : one counting sort, linear in
+ * the number of boxes.
+ *
+ * Boxes are meant to be swept, covering an entity's whole motion over the
+ * step, so that fast movers meet what they would have passed through. A
+ * box is listed once in every bucket it overlaps, unless it covers more than
+ * SPATIAL_HASH_MAX_CELLS cells : it is then kept apart & tested against all
+ * others. Memory is thus bounded by the maximum bucket count & the number
+ * of boxes, whatever the world's extent or the entities' speed.
+ */
+class SpatialHash
+{
+	public:
+		struct Box
+		{
+			double minX;
+			double minY;
+			double maxX;
+			double maxY;
+		};
+
+		/* Indices into the built boxes, lower one first */
+		typedef std::pair<Uint32, Uint32> Pair;
+
+	private:
+		double _inverseCellSize;
+		std::size_t _minimumBuckets;
+		Uint32 _mask;
+
+		std::vector<Box> _boxes;
+
+		/* Bucket b lists _entries[_starts[b]] to _entries[_starts[b + 1] - 1] */
+		std::vector<Uint32> _starts;
+		std::vector<Uint32> _entries;
+		std::vector<Uint32> _oversized;
+
+		/* Per box : its distinct buckets, none for oversized ones */
+		std::vector<Uint32> _boxBuckets;
+		std::vector<Uint8> _boxBucketCounts;
+
+		/* Visit stamps, to return each box once per query */
+		std::vector<Uint32> _marks;
+		Uint32 _generation;
+
+		Uint32 getBucket(Sint64 const cellX, Sint64 const cellY) const;
+		Sint64 getCell(double const coordinate) const;
+
+	public:
+		SpatialHash(double const cellSize,
+			std::size_t const buckets = SPATIAL_HASH_BUCKETS);
+
+		void build(std::vector<Box> const & boxes);
+		void clear(void);
+
+		/* Every overlapping pair, each reported once */
+		void findPairs(std::vector<Pair> & pairs) const;
+
+		/* Every box overlapping <box>, each reported once */
+		void query(Box const & box, std::vector<Uint32> & found);
+
+		std::size_t getSize(void) const;
+		std::size_t getOversized(void) const;
+		std::size_t getMemoryUsage(void) const;
+
+		/* Bounds included : boxes that touch overlap */
+		static bool overlap(Box const & a, Box const & b);
+};
+
+#endif // SPATIAL_HASH_HPP_INCLUDED
@@ -0,0 +1,87 @@
+#include "StartupTrace.hpp"
+#include <VBN/Logging.hpp>
+
+bool StartupTrace::_firstFrame(false);
+
+StartupTrace::Phase::Phase(std::string const & name) :
+	_name(name),
+	_start(SDL_GetPerformanceCounter())
+{}
+
+StartupTrace::Phase::~Phase(void)
+{
+	StartupTrace::getInstance()->record(_name, _start, SDL_GetPerformanceCounter());
+}
+
+StartupTrace::StartupTrace(void) :
+	_origin(SDL_GetPerformanceCounter())
+{}
+
+std::shared_ptr<StartupTrace> StartupTrace::getInstance(void)
+{
+	static std::shared_ptr<StartupTrace> instance(new StartupTrace);
+	return instance;
+}
+
+double StartupTrace::toMilliseconds(Uint64 const ticks) const
+{
+	return (1000. * ticks) / SDL_GetPerformanceFrequency();
+}
+
+void StartupTrace::record(std::string const & name,
+	Uint64 const start, Uint64 const end)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_records.push_back({ name, start, end });
+}
+
+void StartupTrace::defer(std::string const & name, std::function<void(void)> task)
+{
+	if (_firstFrame)
+	{
+		Phase phase(name);
+		task();
+		return;
+	}
+
+	_deferred.push_back({ name, task });
+}
+
+void StartupTrace::markFirstFrame(void)
+{
+	if (_firstFrame)
+		return;
+	_firstFrame = true;
+
+	record("first frame", _origin, SDL_GetPerformanceCounter());
+	log();
+
+	std::size_t const logged(_records.size());
+	for (auto & deferred : _deferred)
+	{
+		Phase phase(deferred.first + " (deferred)");
+		deferred.second();
+	}
+	_deferred.clear();
+	log(logged);
+}
+
+bool StartupTrace::isFirstFrameDone(void)
+{
+	return _firstFrame;
+}
+
+void StartupTrace::log(std::size_t const first) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (std::size_t index(first); index < _records.size(); ++index)
+	{
+		Record const & record(_records[index]);
+		INFO(SDL_LOG_CATEGORY_APPLICATION,
+			"Startup : %-24s at %8.2f ms, took %8.2f ms",
+			record.name.c_str(),
+			toMilliseconds(record.start - _origin),
+			toMilliseconds(record.end - record.start));
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef STARTUP_TRACE_HPP_INCLUDED
+#define STARTUP_TRACE_HPP_INCLUDED
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Wall time of every startup phase, from the first getInstance() call (the
+ * top of main) to the first displayed frame, logged once that frame is out.
+ *
+ * Work that the first frame does not need can be deferred : it runs, traced
+ * too, right after the first frame.
+ */
+class StartupTrace
+{
+	public:
+		/* Traces its own lifetime */
+		class Phase
+		{
+			private:
+				std::string const _name;
+				Uint64 const _start;
+
+			public:
+				Phase(std::string const & name);
+				~Phase(void);
+		};
+
+	private:
+		struct Record
+		{
+			std::string name;
+			Uint64 start;
+			Uint64 end;
+		};
+
+		mutable std::mutex _mutex;
+		Uint64 const _origin;
+		std::vector<Record> _records;
+		std::vector<std::pair<std::string, std::function<void(void)>>> _deferred;
+		static bool _firstFrame;
+
+		StartupTrace(void);
+
+		double toMilliseconds(Uint64 const ticks) const;
+
+	public:
+		static std::shared_ptr<StartupTrace> getInstance(void);
+
+		void record(std::string const & name, Uint64 const start, Uint64 const end);
+		void defer(std::string const & name, std::function<void(void)> task);
+
+		/* Once the first frame is out : callers check isFirstFrameDone() */
+		void markFirstFrame(void);
+		static bool isFirstFrameDone(void);
+
+		void log(std::size_t const first = 0) const;
+};
+
+#endif // STARTUP_TRACE_HPP_INCLUDED
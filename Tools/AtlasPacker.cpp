@@ -0,0 +1,401 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Transparent texels around every sprite, so filtering never bleeds */
+#define ATLAS_PADDING 1
+#define ATLAS_MIN_SIZE 64
+#define ATLAS_DEFAULT_MAX_SIZE 2048
+
+/*
+ * Build-time tool merging sprites into as few atlas pages as possible :
+ *
+ *   atlaspacker [--max <size>] <output prefix> <source>...
+ *
+ * with <source> either :
+ * - sprite:<name>:<image> : the whole image is one clip
+ * - sheet:<image>:<clip file> : every clip of a sprite sheet
+ *
+ * Writes <prefix>_<page>.png & <prefix>_<page>.clips, the latter in the
+ * SpriteSheet clip file format. Sprites are placed with MaxRects (best short
+ * side fit, largest first), on the smallest power-of-two page that holds
+ * them all ; only when <max>x<max> is not enough is a new page started.
+ * Identical clips of a sheet are stored once and share their rectangle.
+ */
+
+namespace
+{
+	struct Sprite
+	{
+		std::vector<std::string> names;
+		SDL_Surface * source;
+		SDL_Rect clip;
+		int page;
+		SDL_Point position;
+	};
+
+	class MaxRects
+	{
+		private:
+			std::vector<SDL_Rect> _free;
+
+			static bool contains(SDL_Rect const & outer, SDL_Rect const & inner)
+			{
+				return inner.x >= outer.x && inner.y >= outer.y
+					&& inner.x + inner.w <= outer.x + outer.w
+					&& inner.y + inner.h <= outer.y + outer.h;
+			}
+
+			/* Splits every free rectangle the placed one overlaps */
+			void split(SDL_Rect const & used)
+			{
+				std::vector<SDL_Rect> next;
+
+				for (SDL_Rect const & free : _free)
+				{
+					if (used.x >= free.x + free.w || used.x + used.w <= free.x
+						|| used.y >= free.y + free.h || used.y + used.h <= free.y)
+					{
+						next.push_back(free);
+						continue;
+					}
+
+					if (used.x > free.x)
+						next.push_back({ free.x, free.y, used.x - free.x, free.h });
+					if (used.x + used.w < free.x + free.w)
+						next.push_back({ used.x + used.w, free.y,
+							free.x + free.w - used.x - used.w, free.h });
+					if (used.y > free.y)
+						next.push_back({ free.x, free.y, free.w, used.y - free.y });
+					if (used.y + used.h < free.y + free.h)
+						next.push_back({ free.x, used.y + used.h,
+							free.w, free.y + free.h - used.y - used.h });
+				}
+
+				/* Drop rectangles contained in another one */
+				_free.clear();
+				for (std::size_t i(0); i < next.size(); ++i)
+				{
+					bool redundant(false);
+					for (std::size_t j(0); j < next.size() && !redundant; ++j)
+						redundant = (i != j) && contains(next[j], next[i])
+							&& (!contains(next[i], next[j]) || j < i);
+					if (!redundant)
+						_free.push_back(next[i]);
+				}
+			}
+
+		public:
+			MaxRects(int const width, int const height) :
+				_free{ { 0, 0, width, height } }
+			{}
+
+			bool insert(int const width, int const height, SDL_Point & position)
+			{
+				int bestShort(std::numeric_limits<int>::max());
+				int bestLong(std::numeric_limits<int>::max());
+				SDL_Rect best{ 0, 0, 0, 0 };
+
+				for (SDL_Rect const & free : _free)
+				{
+					if (free.w < width || free.h < height)
+						continue;
+
+					int const leftW(free.w - width), leftH(free.h - height);
+					int const shortSide(std::min(leftW, leftH));
+					int const longSide(std::max(leftW, leftH));
+
+					if (shortSide < bestShort
+						|| (shortSide == bestShort && longSide < bestLong))
+					{
+						bestShort = shortSide;
+						bestLong = longSide;
+						best = { free.x, free.y, width, height };
+					}
+				}
+
+				if (!best.w)
+					return false;
+
+				split(best);
+				position = { best.x, best.y };
+				return true;
+			}
+	};
+
+	bool sameClip(Sprite const & a, Sprite const & b)
+	{
+		return a.source == b.source && a.clip.x == b.clip.x && a.clip.y == b.clip.y
+			&& a.clip.w == b.clip.w && a.clip.h == b.clip.h;
+	}
+
+	/* Places as many of <sprites> (largest first) as fit on one page */
+	std::size_t fill(std::vector<Sprite *> const & sprites,
+		int const width, int const height, int const page)
+	{
+		MaxRects packer(width, height);
+		std::size_t placed(0);
+
+		for (Sprite * sprite : sprites)
+		{
+			if (sprite->page >= 0)
+				continue;
+
+			if (packer.insert(sprite->clip.w + 2 * ATLAS_PADDING,
+				sprite->clip.h + 2 * ATLAS_PADDING, sprite->position))
+			{
+				sprite->page = page;
+				sprite->position.x += ATLAS_PADDING;
+				sprite->position.y += ATLAS_PADDING;
+				++placed;
+			}
+		}
+
+		return placed;
+	}
+
+	bool loadSheet(std::string const & image, std::string const & clipFile,
+		std::vector<SDL_Surface *> & surfaces, std::vector<Sprite> & sprites)
+	{
+		std::ifstream clips(clipFile);
+		SDL_Surface * source(nullptr);
+		std::string line;
+
+		/* Once in <surfaces>, the image is freed with the others */
+		if (!clips || !(source = IMG_Load(image.c_str())))
+			return false;
+		surfaces.push_back(source);
+
+		while (std::getline(clips, line))
+		{
+			std::istringstream fields(line.substr(0, line.find('#')));
+			Sprite sprite{ {}, source, { 0, 0, 0, 0 }, -1, { 0, 0 } };
+			std::string name;
+
+			if (!(fields >> name))
+				continue;
+			if (!(fields >> sprite.clip.x >> sprite.clip.y
+				>> sprite.clip.w >> sprite.clip.h))
+				return false;
+
+			auto const same(std::find_if(sprites.begin(), sprites.end(),
+				[&sprite](Sprite const & other) { return sameClip(sprite, other); }));
+			if (same != sprites.end())
+				same->names.push_back(name);
+			else
+			{
+				sprite.names.push_back(name);
+				sprites.push_back(sprite);
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	int maxSize(ATLAS_DEFAULT_MAX_SIZE);
+	int arg(1);
+
+	if (arg + 1 < argc && std::string(argv[arg]) == "--max")
+	{
+		maxSize = std::atoi(argv[arg + 1]);
+		arg += 2;
+	}
+
+	if (arg + 1 >= argc || maxSize < ATLAS_MIN_SIZE)
+	{
+		std::cerr << "Usage : " << argv[0]
+			<< " [--max <size>] <output prefix> sprite:<name>:<image>"
+			" | sheet:<image>:<clip file>..." << std::endl;
+		return 1;
+	}
+
+	std::string const prefix(argv[arg++]);
+	std::vector<SDL_Surface *> surfaces;
+	std::vector<Sprite> sprites;
+
+	SDL_Init(0);
+	IMG_Init(IMG_INIT_PNG);
+
+	for (; arg < argc; ++arg)
+	{
+		std::string const spec(argv[arg]);
+		std::size_t const first(spec.find(':'));
+		std::size_t const second(spec.find(':', first + 1));
+		bool loaded(false);
+
+		if (first != std::string::npos && second != std::string::npos)
+		{
+			std::string const kind(spec.substr(0, first));
+			std::string const middle(spec.substr(first + 1, second - first - 1));
+			std::string const last(spec.substr(second + 1));
+
+			if (kind == "sheet")
+				loaded = loadSheet(middle, last, surfaces, sprites);
+			else if (kind == "sprite")
+			{
+				SDL_Surface * source(IMG_Load(last.c_str()));
+				if (source)
+				{
+					surfaces.push_back(source);
+					sprites.push_back({ { middle }, source,
+						{ 0, 0, source->w, source->h }, -1, { 0, 0 } });
+					loaded = true;
+				}
+			}
+		}
+
+		if (!loaded)
+		{
+			std::cerr << "Cannot load \"" << spec << "\" : "
+				<< SDL_GetError() << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<Sprite *> order;
+	for (Sprite & sprite : sprites)
+	{
+		if (sprite.clip.w + 2 * ATLAS_PADDING > maxSize
+			|| sprite.clip.h + 2 * ATLAS_PADDING > maxSize)
+		{
+			std::cerr << sprite.names.front() << " does not fit in "
+				<< maxSize << "x" << maxSize << std::endl;
+			return 1;
+		}
+		order.push_back(&sprite);
+	}
+
+	std::stable_sort(order.begin(), order.end(),
+		[](Sprite const * a, Sprite const * b)
+		{
+			return a->clip.w * a->clip.h > b->clip.w * b->clip.h;
+		});
+
+	/*
+	 * Each page : the smallest power-of-two size (by area, then squareness)
+	 * holding every remaining sprite, else the largest page, filled as much
+	 * as possible
+	 */
+	std::vector<std::pair<int, int>> sizes;
+	for (int width(ATLAS_MIN_SIZE); width <= maxSize; width *= 2)
+		for (int height(ATLAS_MIN_SIZE); height <= maxSize; height *= 2)
+			sizes.push_back({ width, height });
+	std::stable_sort(sizes.begin(), sizes.end(),
+		[](std::pair<int, int> const & a, std::pair<int, int> const & b)
+		{
+			if (a.first * a.second != b.first * b.second)
+				return a.first * a.second < b.first * b.second;
+			return std::abs(a.first - a.second) < std::abs(b.first - b.second);
+		});
+
+	std::vector<std::pair<int, int>> pages;
+	std::size_t remaining(sprites.size());
+
+	while (remaining)
+	{
+		int const page(static_cast<int>(pages.size()));
+		std::pair<int, int> chosen(maxSize, maxSize);
+		bool fitted(false);
+
+		for (std::pair<int, int> const & size : sizes)
+		{
+			std::vector<Sprite *> trial;
+			for (Sprite * sprite : order)
+				if (sprite->page < 0)
+					trial.push_back(sprite);
+
+			std::vector<Sprite> saved;
+			for (Sprite * sprite : trial)
+				saved.push_back(*sprite);
+
+			if (fill(trial, size.first, size.second, page) == trial.size())
+			{
+				chosen = size;
+				fitted = true;
+				break;
+			}
+
+			/* Undo the partial trial */
+			for (std::size_t i(0); i < trial.size(); ++i)
+				*trial[i] = saved[i];
+		}
+
+		if (!fitted)
+		{
+			std::size_t const placed(fill(order, maxSize, maxSize, page));
+			if (placed < remaining)
+				std::cerr << "Warning : page " << page << " is full, "
+					<< (remaining - placed) << " sprites spill over" << std::endl;
+			remaining -= placed;
+		}
+		else
+			remaining = 0;
+
+		pages.push_back(chosen);
+	}
+
+	/* Write every page & its clip file */
+	long long usedTexels(0), totalTexels(0);
+	for (std::size_t page(0); page < pages.size(); ++page)
+	{
+		SDL_Surface * atlas(SDL_CreateRGBSurfaceWithFormat(0,
+			pages[page].first, pages[page].second, 32, SDL_PIXELFORMAT_RGBA32));
+		std::string const base(prefix + "_" + std::to_string(page));
+		std::ofstream clips(base + ".clips");
+
+		if (!atlas || !clips)
+		{
+			std::cerr << "Cannot create \"" << base << "\"" << std::endl;
+			return 1;
+		}
+
+		clips << "# Generated by atlaspacker : <name> <x> <y> <w> <h>\n";
+		for (Sprite const & sprite : sprites)
+		{
+			if (sprite.page != static_cast<int>(page))
+				continue;
+
+			SDL_Rect destination{ sprite.position.x, sprite.position.y,
+				sprite.clip.w, sprite.clip.h };
+			SDL_SetSurfaceBlendMode(sprite.source, SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(sprite.source, &sprite.clip, atlas, &destination);
+
+			for (std::string const & name : sprite.names)
+				clips << name << ' ' << sprite.position.x << ' ' << sprite.position.y
+					<< ' ' << sprite.clip.w << ' ' << sprite.clip.h << '\n';
+			usedTexels += sprite.clip.w * sprite.clip.h;
+		}
+		totalTexels += atlas->w * atlas->h;
+
+		if (IMG_SavePNG(atlas, (base + ".png").c_str()) != 0)
+		{
+			std::cerr << "Cannot write \"" << base << ".png\" : "
+				<< IMG_GetError() << std::endl;
+			return 1;
+		}
+		SDL_FreeSurface(atlas);
+
+		std::cout << base << " : " << pages[page].first << "x"
+			<< pages[page].second << std::endl;
+	}
+
+	std::cout << sprites.size() << " sprites on " << pages.size() << " page(s), "
+		<< (100. * usedTexels / totalTexels) << "% texels used" << std::endl;
+
+	for (SDL_Surface * surface : surfaces)
+		SDL_FreeSurface(surface);
+	IMG_Quit();
+	SDL_Quit();
+
+	return 0;
+}
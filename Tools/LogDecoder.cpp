@@ -0,0 +1,135 @@
+#include <SDL2/SDL.h>
+#include "../System/FastLog.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Offline formatter for the binary log written by "--binary-log <file>"
+ * (see System/FastLog.hpp) :
+ *
+ *   logdecoder <file>
+ *
+ * prints one "[milliseconds] PRIORITY message" line per entry, times being
+ * relative to the first entry.
+ */
+
+namespace
+{
+	struct Site
+	{
+		Uint8 priority;
+		Sint32 category;
+		std::string format;
+	};
+
+	char const * const PRIORITY_NAMES[SDL_NUM_LOG_PRIORITIES] =
+	{
+		"", "VERBOSE", "DEBUG", "INFO", "WARN", "ERROR", "CRITICAL"
+	};
+
+	template<typename T>
+	bool read(std::ifstream & input, T & value)
+	{
+		return static_cast<bool>(input.read(reinterpret_cast<char *>(&value),
+			sizeof(T)));
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	if (argc != 2)
+	{
+		std::cerr << "Usage : " << argv[0] << " <file>" << std::endl;
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	char magic[4];
+	Uint32 version(0);
+	Uint64 frequency(0);
+
+	if (!input.read(magic, 4) || std::memcmp(magic, FAST_LOG_MAGIC, 4)
+		|| !read(input, version) || version != FAST_LOG_VERSION
+		|| !read(input, frequency) || !frequency)
+	{
+		std::cerr << "\"" << argv[1] << "\" is not a log file" << std::endl;
+		return 1;
+	}
+
+	std::map<Uint32, Site> sites;
+	std::vector<char> payload;
+	Uint64 origin(0);
+	bool first(true);
+	Uint8 kind;
+
+	while (read(input, kind))
+	{
+		if (kind == FastLog::SITE)
+		{
+			Uint32 id;
+			Site site;
+			Uint16 length;
+
+			if (!read(input, id) || !read(input, site.priority)
+				|| !read(input, site.category) || !read(input, length))
+				break;
+			site.format.resize(length);
+			if (!input.read(&site.format[0], length))
+				break;
+			sites[id] = site;
+		}
+		else if (kind == FastLog::ENTRY)
+		{
+			Uint32 id;
+			Uint64 time;
+			Uint16 size;
+
+			if (!read(input, id) || !read(input, time) || !read(input, size))
+				break;
+			payload.resize(size);
+			if (size && !input.read(payload.data(), size))
+				break;
+
+			std::map<Uint32, Site>::const_iterator site(sites.find(id));
+			if (site == sites.end())
+			{
+				std::cerr << "Entry for unknown site " << id << std::endl;
+				return 1;
+			}
+
+			if (first)
+			{
+				origin = time;
+				first = false;
+			}
+
+			std::printf("[%12.3f] %-8s %s\n",
+				(1000. * (time - origin)) / frequency,
+				site->second.priority < SDL_NUM_LOG_PRIORITIES ?
+					PRIORITY_NAMES[site->second.priority] : "?",
+				FastLog::format(site->second.format.c_str(),
+					payload.data(), size).c_str());
+		}
+		else if (kind == FastLog::DROPPED)
+		{
+			Uint32 thread, dropped;
+
+			if (!read(input, thread) || !read(input, dropped))
+				break;
+			std::printf("%u entries dropped by thread %u\n", dropped, thread);
+		}
+		else
+		{
+			std::cerr << "Corrupted record" << std::endl;
+			return 1;
+		}
+	}
+
+	/* A record cut short (crash, still being written) ends the output */
+	return 0;
+}
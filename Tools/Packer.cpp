@@ -0,0 +1,226 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include "../System/AssetPack.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/*
+ * Build-time tool writing an AssetPack (see System/AssetPack.hpp) :
+ *
+ *   packer [--audio <frequency> <channels>] <output> <kind>:<name>:<path>...
+ *
+ * with <kind> one of :
+ * - image : decoded & converted to ARGB8888, the usual texture format
+ * - sample : WAV converted to 16-bit PCM at the mixer's output rate
+ * - font, music, data : stored as is, opened from memory at runtime
+ *
+ * <name> is the AssetLoader name, e.g. for the sprite atlas (see
+ * Graphics/SpriteSheet.hpp) :
+ *
+ *   image:sprites:assets/textures/sprites_0.png
+ *   data:sprites.clips:assets/textures/sprites_0.clips
+ */
+
+namespace
+{
+	struct Packed
+	{
+		AssetPack::Entry entry;
+		std::vector<char> data;
+	};
+
+	bool readFile(std::string const & path, std::vector<char> & data)
+	{
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+			return false;
+
+		data.assign(std::istreambuf_iterator<char>(input),
+			std::istreambuf_iterator<char>());
+		return !data.empty();
+	}
+
+	bool packImage(std::string const & path, Packed & packed)
+	{
+		SDL_Surface * loaded(IMG_Load(path.c_str()));
+		if (!loaded)
+			return false;
+
+		SDL_Surface * converted(SDL_ConvertSurfaceFormat(loaded,
+			SDL_PIXELFORMAT_ARGB8888, 0));
+		SDL_FreeSurface(loaded);
+		if (!converted)
+			return false;
+
+		packed.entry.kind = AssetPack::PIXELS;
+		packed.entry.format = SDL_PIXELFORMAT_ARGB8888;
+		packed.entry.width = converted->w;
+		packed.entry.height = converted->h;
+		packed.entry.pitch = converted->pitch;
+
+		char const * pixels(static_cast<char const *>(converted->pixels));
+		packed.data.assign(pixels, pixels + converted->pitch * converted->h);
+		SDL_FreeSurface(converted);
+
+		return true;
+	}
+
+	bool packSample(std::string const & path, int const frequency,
+		int const channels, Packed & packed)
+	{
+		SDL_AudioSpec spec;
+		Uint8 * samples(nullptr);
+		Uint32 length(0);
+		SDL_AudioCVT conversion;
+
+		if (!SDL_LoadWAV(path.c_str(), &spec, &samples, &length))
+			return false;
+
+		if (SDL_BuildAudioCVT(&conversion, spec.format, spec.channels, spec.freq,
+			MIX_DEFAULT_FORMAT, static_cast<Uint8>(channels), frequency) < 0)
+		{
+			SDL_FreeWAV(samples);
+			return false;
+		}
+
+		std::vector<Uint8> buffer(length * conversion.len_mult);
+		std::memcpy(buffer.data(), samples, length);
+		SDL_FreeWAV(samples);
+
+		conversion.buf = buffer.data();
+		conversion.len = static_cast<int>(length);
+		if (conversion.needed && SDL_ConvertAudio(&conversion) < 0)
+			return false;
+
+		packed.entry.kind = AssetPack::PCM;
+		packed.entry.format = MIX_DEFAULT_FORMAT;
+		packed.entry.width = frequency;
+		packed.entry.height = channels;
+		packed.data.assign(buffer.begin(),
+			buffer.begin() + (conversion.needed ? conversion.len_cvt : length));
+
+		return true;
+	}
+
+	Uint64 align(Uint64 const offset)
+	{
+		return (offset + ASSET_PACK_ALIGNMENT - 1)
+			/ ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	int frequency(MIX_DEFAULT_FREQUENCY), channels(2);
+	int arg(1);
+
+	if (arg + 2 < argc && std::string(argv[arg]) == "--audio")
+	{
+		frequency = std::atoi(argv[arg + 1]);
+		channels = std::atoi(argv[arg + 2]);
+		arg += 3;
+	}
+
+	if (arg + 1 >= argc)
+	{
+		std::cerr << "Usage : " << argv[0]
+			<< " [--audio <frequency> <channels>] <output> <kind>:<name>:<path>..."
+			<< std::endl;
+		return 1;
+	}
+
+	std::string const output(argv[arg++]);
+	std::vector<Packed> pack;
+
+	SDL_Init(0);
+	IMG_Init(IMG_INIT_PNG);
+
+	for (; arg < argc; ++arg)
+	{
+		std::string const spec(argv[arg]);
+		std::size_t const first(spec.find(':'));
+		std::size_t const second(spec.find(':', first + 1));
+
+		if (first == std::string::npos || second == std::string::npos
+			|| second - first - 1 >= ASSET_PACK_NAME_SIZE)
+		{
+			std::cerr << "Invalid asset \"" << spec << "\"" << std::endl;
+			return 1;
+		}
+
+		std::string const kind(spec.substr(0, first));
+		std::string const name(spec.substr(first + 1, second - first - 1));
+		std::string const path(spec.substr(second + 1));
+		Packed packed{};
+		bool packedOk(false);
+
+		std::strncpy(packed.entry.name, name.c_str(), ASSET_PACK_NAME_SIZE - 1);
+
+		if (kind == "image")
+			packedOk = packImage(path, packed);
+		else if (kind == "sample")
+			packedOk = packSample(path, frequency, channels, packed);
+		else if (kind == "font" || kind == "music" || kind == "data")
+		{
+			packed.entry.kind = AssetPack::BLOB;
+			packedOk = readFile(path, packed.data);
+		}
+
+		if (!packedOk)
+		{
+			std::cerr << "Cannot pack \"" << spec << "\" : "
+				<< SDL_GetError() << std::endl;
+			return 1;
+		}
+
+		std::cout << name << " : " << packed.data.size() << " bytes" << std::endl;
+		pack.push_back(std::move(packed));
+	}
+
+	/* Lay the data out after the entry table */
+	AssetPack::Header header{};
+	std::memcpy(header.magic, ASSET_PACK_MAGIC, 4);
+	header.version = ASSET_PACK_VERSION;
+	header.count = static_cast<Uint32>(pack.size());
+
+	Uint64 offset(sizeof(AssetPack::Header) + pack.size() * sizeof(AssetPack::Entry));
+	for (Packed & packed : pack)
+	{
+		offset = align(offset);
+		packed.entry.offset = offset;
+		packed.entry.size = packed.data.size();
+		offset += packed.data.size();
+	}
+
+	std::ofstream file(output, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+	for (Packed const & packed : pack)
+		file.write(reinterpret_cast<char const *>(&packed.entry),
+			sizeof(packed.entry));
+
+	for (Packed const & packed : pack)
+	{
+		std::vector<char> const padding(
+			static_cast<std::size_t>(packed.entry.offset
+				- static_cast<Uint64>(file.tellp())), 0);
+		file.write(padding.data(), padding.size());
+		file.write(packed.data.data(), packed.data.size());
+	}
+
+	IMG_Quit();
+	SDL_Quit();
+
+	if (!file)
+	{
+		std::cerr << "Cannot write \"" << output << "\"" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
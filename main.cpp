@@ -8,51 +8,157 @@
 #include <VBN/TrueTypeFontManager.hpp>
 #include <VBN/Logging.hpp>
 #include "Activities/Menu.hpp"
+#include "Activities/Loading.hpp"
 #include "Activities/Global.hpp"
 #include <VBN/Platform.hpp>
 #include <VBN/Mixer.hpp>
+#include "Graphics/GlyphAtlas.hpp"
+#include "Graphics/LogOverlay.hpp"
+#include "System/LogRing.hpp"
+#include "System/Benchmark.hpp"
+#include "System/FrameProfiler.hpp"
+#include "System/AssetLoader.hpp"
+#include "System/AssetPack.hpp"
+#include "System/StartupTrace.hpp"
+#include "System/FastLog.hpp"
+#include "System/JobSystem.hpp"
+#include "Input/InputRecorder.hpp"
+#include "Activities/Tank.hpp"
+#include "Activities/TextDebug.hpp"
+#include "Activities/GameControllerDebug.hpp"
+#include <cstdlib>
+#include <iostream>
 
 using namespace std;
 
 /*
  * TODO:
- * o Add global and local millisecond-to-gametick ratio settings
  * o Modularize menus
  * o Add Joystick API
  */
 
 int main(int argc, char ** argv)
 {
+	/* Startup phases are timed from here */
+	std::shared_ptr<StartupTrace> startup(StartupTrace::getInstance());
+
 	int returnCode(0);
+	unsigned int benchmarkFrames(0);
+	bool eagerInit(false);
+	std::string recordPath, replayPath, binaryLogPath, benchmarkSuite;
+
+	/*
+	 * Command line :
+	 * - "--benchmark [suite] [frames]" runs headless & prints timings, of
+	 *   every suite unless one is named (see System/Benchmark.cpp)
+	 * - "--record <file>" saves every input event & controller poll
+	 * - "--replay <file>" plays such a file back instead of live input
+	 * - "--eager-init" brings every subsystem & codec up before the window
+	 * - "--binary-log <file>" writes FAST_* logs there, unformatted (see
+	 *   Tools/LogDecoder.cpp), instead of the SDL log
+	 */
+	for (int arg(1); arg < argc; ++arg)
+	{
+		std::string const option(argv[arg]);
+
+		if (option == "--benchmark")
+		{
+			benchmarkFrames = BENCHMARK_DEFAULT_FRAMES;
+			if (arg + 1 < argc && argv[arg + 1][0] != '-'
+				&& std::atoi(argv[arg + 1]) <= 0)
+				benchmarkSuite = argv[++arg];
+			if (arg + 1 < argc && std::atoi(argv[arg + 1]) > 0)
+				benchmarkFrames = static_cast<unsigned int>(std::atoi(argv[++arg]));
+		}
+		else if (option == "--record" && arg + 1 < argc)
+			recordPath = argv[++arg];
+		else if (option == "--replay" && arg + 1 < argc)
+			replayPath = argv[++arg];
+		else if (option == "--eager-init")
+			eagerInit = true;
+		else if (option == "--binary-log" && arg + 1 < argc)
+			binaryLogPath = argv[++arg];
+	}
+
+	/* No display nor GPU needed : environment variables still take precedence */
+	if (benchmarkFrames)
+	{
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+	}
 
 	/* SDL sub-logger settings */
 	SDL_LogSetAllPriority(SDL_LOG_PRIORITY_DEBUG);
 
-	/* SDL Modules initialization */
-	SDL_Init(SDL_INIT_EVERYTHING);
-	IMG_Init(IMG_INIT_PNG);
-	TTF_Init();
-	Mix_Init(MIX_INIT_FLAC
-			|MIX_INIT_MID
-			|MIX_INIT_MOD
-			|MIX_INIT_MP3
-			|MIX_INIT_OGG
-			|MIX_INIT_OPUS);
-
-	/* Audio Resources */
+	/*
+	 * Per-frame traces log at VERBOSE : SDL's log would drop them, binary
+	 * logs keep them (unless compiled out, see FAST_LOG_MIN_PRIORITY).
+	 */
+	FastLog::setThreshold(binaryLogPath.empty()
+		? SDL_LOG_PRIORITY_DEBUG : SDL_LOG_PRIORITY_VERBOSE);
+	LogRing::getInstance()->install();
+	FastLog::getInstance()->start(binaryLogPath);
+
+	/*
+	 * SDL Modules initialization : by default, only what the first frame
+	 * needs. Game controllers come up after it (already connected ones then
+	 * arrive as hotplug events) and mixer decoders on first use (see
+	 * AssetLoader::request). The Mixer opens the audio subsystem itself.
+	 */
+	{
+		StartupTrace::Phase phase("SDL_Init");
+		if (eagerInit)
+			SDL_Init(SDL_INIT_EVERYTHING);
+		else
+			SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER);
+	}
+	{
+		StartupTrace::Phase phase("IMG_Init");
+		IMG_Init(IMG_INIT_PNG);
+	}
+	{
+		StartupTrace::Phase phase("TTF_Init");
+		TTF_Init();
+	}
+	if (eagerInit)
+	{
+		StartupTrace::Phase phase("Mix_Init");
+		Mix_Init(MIX_INIT_FLAC
+				|MIX_INIT_MID
+				|MIX_INIT_MOD
+				|MIX_INIT_MP3
+				|MIX_INIT_OGG
+				|MIX_INIT_OPUS);
+	}
+	else
+		startup->defer("SDL_InitSubSystem", []
+		{
+			SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER | SDL_INIT_HAPTIC);
+		});
+
+	/*
+	 * Audio Resources : samples & musics are decoded by the AssetLoader
+	 * (see Menu::Factory::getAssets), the Mixer only opens the device
+	 */
 	std::string audioAssets("assets/audio/");
-	std::map<std::string, std::string>
-		samples{ {"sample.wav", "drum"} },
-		musics{ {"music.flac", "ftl"} };
+	std::map<std::string, std::string> samples, musics;
 
-	/* Text displaying resources */
+	/* Text displaying resources : only the fonts Renderer::printText uses */
 	std::string ttfAssets("assets/fonts/");
-	std::set<std::string> fontNames{ "open-moji-color", "emoji", "courier", "arial" };
+	std::set<std::string> fontNames{ "open-moji-color", "courier" };
+
+	/* Outlives the try block : cached textures are released before it */
+	std::shared_ptr<Platform> platform;
 
 	try
 	{
-		/* Acquire info on available hardware */
-		Introspection::perform();
+		/* Acquire info on available hardware : nothing at startup needs it */
+		if (eagerInit)
+		{
+			StartupTrace::Phase phase("Introspection");
+			Introspection::perform();
+		}
 
 		/*
 		 * Initialize the current Platform :
@@ -60,33 +166,102 @@ int main(int argc, char ** argv)
 		 * - GameControllerManager : manages GameController objects (if any)
 		 * - Mixer : handles sound effects
 		 */
-		std::shared_ptr<Platform> platform(new Platform(
-			new WindowManager,
-			new GameControllerManager,
-			new Mixer(0, audioAssets, samples, musics)));
+		{
+			StartupTrace::Phase phase("Platform");
+			platform.reset(new Platform(
+				new WindowManager,
+				new GameControllerManager,
+				new Mixer(0, audioAssets, samples, musics)));
+		}
 
 		/* Instantiate the Main Window and its internal TrueTypeFontManager */
-		platform->getWindowManager()->addWindow(
-			"mainWindow",
-			"SDL Main Window",
-			SDL_WINDOWPOS_CENTERED,
-			SDL_WINDOWPOS_CENTERED,
-			1600, 900,
-			Window::RatioType::FIXED_RATIO_STRETCH,
-			SDL_WINDOW_SHOWN|SDL_WINDOW_RESIZABLE,
-			SDL_RENDERER_ACCELERATED,
-			std::make_shared<TrueTypeFontManager>(ttfAssets, fontNames));
+		{
+			StartupTrace::Phase phase("Main window");
+			platform->getWindowManager()->addWindow(
+				"mainWindow",
+				"SDL Main Window",
+				SDL_WINDOWPOS_CENTERED,
+				SDL_WINDOWPOS_CENTERED,
+				1600, 900,
+				Window::RatioType::FIXED_RATIO_STRETCH,
+				SDL_WINDOW_SHOWN|SDL_WINDOW_RESIZABLE,
+				benchmarkFrames ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED,
+				std::make_shared<TrueTypeFontManager>(ttfAssets, fontNames));
+		}
+
+		/* Glyph atlases open their own handles on the same font files */
+		TextCache::getInstance()->setFontDirectory(ttfAssets);
+
+		/* Packed assets (see Tools/Packer.cpp) if built, else loose files */
+		{
+			StartupTrace::Phase phase("Asset pack");
+			std::shared_ptr<AssetPack> pack(std::make_shared<AssetPack>());
+			if (pack->open(ASSET_PACK_PATH))
+				AssetLoader::getInstance()->setPack(pack);
+			else
+				INFO(SDL_LOG_CATEGORY_APPLICATION,
+					"No asset pack at \"%s\" : loading loose files", ASSET_PACK_PATH);
+		}
 
 		/* Send Hardware Introspection results to logging facility */
-		Introspection::log();
+		if (eagerInit)
+			Introspection::log();
+		else
+			startup->defer("Introspection", []
+			{
+				Introspection::perform();
+				Introspection::log();
+			});
+
+		if (benchmarkFrames)
+		{
+			Benchmark benchmark(platform, benchmarkFrames);
+			benchmark.addScenario("menu", &Menu::Factory::createMenu);
+			benchmark.addScenario("tank", &Tank::Factory::createGameControllerDebug);
+			benchmark.addScenario("text-debug", &TextDebug::Factory::createTextDebug);
+			benchmark.addScenario("game-controller-debug",
+				&GameControllerDebug::Factory::createGameControllerDebug);
+			benchmark.addIdleScenario("menu", &Menu::Factory::createMenu);
+			benchmark.addPlayerScenario("game-controller-debug",
+				&GameControllerDebug::Factory::createGameControllerDebug);
+			if (!benchmark.run(std::cout, benchmarkSuite))
+			{
+				std::string suites;
+				for (std::string const & suite : benchmark.getSuites())
+					suites += " " + suite;
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+					"Unknown benchmark suite \"%s\", pick one of :%s",
+					benchmarkSuite.c_str(), suites.c_str());
+				returnCode = -1;
+			}
+		}
+		else
+		{
+			/* Replays are for hitch hunting : graph frame times from the start */
+			if (!replayPath.empty()
+				&& InputRecorder::getInstance()->startReplay(replayPath))
+				FrameProfiler::getInstance()->setEnabled(true);
+			else if (!recordPath.empty())
+				InputRecorder::getInstance()->startRecording(recordPath);
+
+			/* Instantiate Main Menu, behind a loading screen for its assets */
+			std::shared_ptr<GameContext> menu(Loading::Factory::createLoading(
+				platform,
+				Menu::Factory::getAssets(),
+				&Menu::Factory::createMenu));
+			/* Instantiate Game Engine with Main Menu as initial context */
+			std::shared_ptr<Engine> engine(new Engine(menu));
 
-		/* Instantiate Main Menu */
-		std::shared_ptr<GameContext> menu(Menu::Factory::createMenu(platform));
-		/* Instantiate Game Engine with Main Menu as initial context */
-		std::shared_ptr<Engine> engine(new Engine(menu));
+			/*
+			 * Start Engine Main Loop : the argument is the global
+			 * millisecond-to-gametick ratio, contexts may rescale it locally
+			 * (see GameContext::setTickRatio & setMaxUpdateRate)
+			 */
+			engine->run(1.f);
 
-		/* Start Engine Main Loop */
-		engine->run(1.f);
+			/* Flush & close the recording */
+			InputRecorder::getInstance()->stop();
+		}
 	}
 	catch (Exception const & exc)
 	{
@@ -94,6 +269,20 @@ int main(int argc, char ** argv)
 		returnCode = -1;
 	}
 
+	/*
+	 * Release cached textures while their renderer still exists, & fonts
+	 * before TTF_Quit, however the try block was left
+	 */
+	AssetLoader::getInstance()->clear();
+	LogOverlay::getInstance()->clear();
+	TextCache::getInstance()->clear();
+	platform.reset();
+
+	JobSystem::getInstance()->stop();
+
+	/* Drain what is left, while SDL's log still works */
+	FastLog::getInstance()->stop();
+
 	/* SDL modules cleanup */
 	Mix_Quit();
 	IMG_Quit();